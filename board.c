@@ -6,9 +6,11 @@
  *
  * 실제로는 C 소스이지만 내부적으로 C++ API(rpi-rgb-led-matrix)를 호출하므로
  * 컴파일 시 g++ 링커 옵션(-lstdc++ -lrgbmatrix 등)이 필요합니다.
+ * 그리기 자체는 board_render.c, 메모리 프레임버퍼 백엔드는 board_fb.c에 있습니다.
  *
  * 컴파일 예:
- *   g++ -O2 -o board board.c -lstdc++ -lrgbmatrix -lpthread -lm
+ *   g++ -O2 -o board board.c board_render.c board_fb.c trace.c -lstdc++ -lrgbmatrix -lpthread -lm
+ *   (매트릭스 없는 환경: g++ -O2 -DBOARD_NO_MATRIX -o board board.c board_render.c board_fb.c trace.c -lpthread)
  *
  * 설치(옵션):
  *   sudo cp board /usr/local/bin/
@@ -16,146 +18,532 @@
  *
  * 실행 예:
  *   sudo board   (표준입력으로 8줄보드 수신 → 매트릭스 갱신)
+ *   sudo board --shm-fd <N> --event-fd <M>
+ *                (client가 fork+exec 할 때 사용. 공유 메모리 프레임 수신, board_shm.h 참고)
+ *   추가 옵션:
+ *     --animate          모든 프레임의 바뀐 셀을 색 페이드로 전환
+ *                        (없으면 BOARD_FRAME_ANIMATE 힌트가 붙은 프레임만)
+ *     --anim-frames <N>  페이드 길이 (vsync 프레임 수, 기본 24, 0이면 애니메이션 끔)
+ *     --framebuffer      LED 매트릭스 대신 메모리 프레임버퍼에 그림 (BOARD_NO_MATRIX 빌드는 항상)
+ *     --dump-dir <DIR>   프레임버퍼가 표시하는 프레임마다 DIR/frame_NNNNNN.ppm 저장
+ *     --record <FILE>    받은 보드를 8줄 텍스트로 FILE에 기록 (board_bench 재생용)
+ *                        (shm 모드에서 건너뛴 프레임도 링에 남아 있으면 순서대로 기록.
+ *                         링 크기보다 더 밀려 이미 덮어써진 프레임은 기록되지 않음)
+ *     --trace <FILE>     종료 시 렌더 단계 span을 Chrome trace-event JSON으로 저장 (trace.h)
+ *
+ * 구조:
+ *   리더 스레드가 입력을 받아 "가장 최신 프레임 하나"만 우편함에 남기고(latest-wins),
+ *   렌더 스레드(main)는 SwapOnVSync 주기에 맞춰 그 프레임을 그립니다.
+ *   보드가 패널 갱신보다 빨리 들어와도 밀린 프레임은 버려지고 화면은 항상 최신 보드를 따라갑니다.
+ *   (버려지는 프레임의 flags는 그려지는 프레임에 OR로 합쳐져 페이드 힌트가 유지됩니다)
+ *   SIGINT/SIGTERM은 시그널 스레드가 sigwait로 받아 렌더 루프를 멈추고,
+ *   main이 리더 스레드를 정리한 뒤 통계를 출력하고 종료합니다.
  */
 
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
+ #include <errno.h>
+ #include <stdint.h>
  #include <unistd.h>
  #include <signal.h>
+ #include <pthread.h>
+ #include <sys/mman.h>
  
+ #ifndef BOARD_NO_MATRIX
  // rpi-rgb-led-matrix의 C++ API 헤더
  #include "rgbmatrix.h"
  #include "graphics.h"
+ #endif
+ 
+ // client ↔ board 공유 메모리 프레임 프로토콜
+ #include "board_shm.h"
+ // 렌더러와 캔버스 백엔드
+ #include "board_render.h"
+ #include "board_fb.h"
+ // 턴 지연 추적
+ #include "trace.h"
+ 
+ // 렌더 스케줄러 설정
+ #define DEFAULT_ANIM_FRAMES 24   // 전환 페이드 길이 (vsync 프레임 수)
+ #define STATS_INTERVAL 100       // 입력 프레임 N개를 그릴 때마다 통계 출력
+ #define FB_VSYNC_HZ 100          // 프레임버퍼 백엔드의 swap 주기 (패널 갱신 흉내)
+ 
+ /*
+  * 리더 스레드 → 렌더 스레드 우편함 (최신 프레임 하나만 보관)
+  */
+ typedef struct {
+     pthread_mutex_t lock;
+     pthread_cond_t  cond;
+     BoardFrame frame;   // 아직 그리지 않은 최신 프레임
+     int   pending;      // frame이 유효하면 1
+     int   eof;          // 입력이 끝나면 1
+     int   stop;         // SIGINT/SIGTERM을 받으면 1
+ } Mailbox;
  
- // 보드 크기: 8×8
- #define BOARD_SIZE 8
+ static Mailbox mailbox = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, BoardFrame(), 0, 0, 0 };
  
- // LED 매트릭스 픽셀 크기
- #define MATRIX_ROWS 64
- #define MATRIX_COLS 64
+ /*
+  * 스케줄러 통계 (received/dropped는 mailbox.lock 아래에서 갱신)
+  */
+ typedef struct {
+     unsigned long received;     // 리더가 받은 프레임 수
+     unsigned long dropped;      // 그려지기 전에 더 새 프레임에 밀려 그 보드가 표시되지 못한 프레임 수
+                                 // (셀은 그대로이고 하이라이트/flags만 다른 프레임은 제외)
+     unsigned long rendered;     // 화면에 반영된 입력 프레임 수
+     unsigned long swaps;        // SwapOnVSync 횟수 (애니메이션 프레임 포함)
+     unsigned long long pixels;  // 지금까지 쓴 픽셀 수
+     uint64_t lat_sum_ns;        // 입력 → 화면 반영 지연 합계
+     uint64_t lat_max_ns;
+ } Stats;
  
- // 셀 하나의 크기 (8)
- #define CELL_COUNT BOARD_SIZE
- #define CELL_SIZE (MATRIX_ROWS / CELL_COUNT)   // = 8
- #define INNER_SIZE (CELL_SIZE - 2)             // = 6 (테두리 1픽셀 마진)
+ static Stats stats;
  
  /*
-  * SIGINT/SIGTERM 시 안전하게 종료할 함수
+  * 공유 메모리 입력 상태 (--shm-fd/--event-fd 로 실행된 경우)
   */
- static void cleanup_and_exit(int signum) {
-     // 단순히 프로세스 종료
-     (void)signum;
-     exit(0);
+ static const BoardShm *shm = NULL;
+ static int event_fd = -1;
+ static uint64_t shm_last_seq = 0;      // 마지막으로 읽은 frame_seq
+ 
+ // --record: 받은 보드를 기록할 파일 (리더 스레드 전용)
+ static FILE *record_fp = NULL;
+ 
+ // --trace: 종료 시 span을 저장할 경로 (NULL이면 요약만 출력)
+ static const char *trace_path = NULL;
+ 
+ #ifndef BOARD_NO_MATRIX
+ /*
+  * LED 매트릭스 백엔드: FrameCanvas 두 개를 BoardCanvas로 감쌈
+  * (SwapOnVSync가 돌려주는 FrameCanvas를 같은 래퍼에 대응시켜 버퍼 식별이 유지되도록 함)
+  */
+ typedef struct {
+     BoardCanvas base;                   // 반드시 첫 멤버
+     rgb_matrix::FrameCanvas *fc;
+ } MatrixCanvas;
+ 
+ typedef struct {
+     BoardBackend base;                  // 반드시 첫 멤버
+     rgb_matrix::RGBMatrix *matrix;
+     MatrixCanvas bufs[2];
+ } MatrixBackend;
+ 
+ static void matrix_set_pixel(BoardCanvas *self, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+     ((MatrixCanvas *)self)->fc->SetPixel(x, y, r, g, b);
  }
  
- int main(int argc, char *argv[]) {
-     // 이 프로그램은 따로 인자를 사용하지 않습니다.
-     (void)argc; (void)argv;
+ static void matrix_fill(BoardCanvas *self, uint8_t r, uint8_t g, uint8_t b) {
+     ((MatrixCanvas *)self)->fc->Fill(r, g, b);
+ }
  
-     // SIGINT, SIGTERM을 받으면 cleanup_and_exit 호출
-     signal(SIGINT, cleanup_and_exit);
-     signal(SIGTERM, cleanup_and_exit);
+ static BoardCanvas *matrix_back(BoardBackend *self) {
+     return &((MatrixBackend *)self)->bufs[0].base;
+ }
  
-     // --------------------------------------------
-     // (1) rpi-rgb-led-matrix 초기화
-     // --------------------------------------------
-     rgb_matrix::RGBMatrix::Options options;
-     options.rows = MATRIX_ROWS;
-     options.cols = MATRIX_COLS;
-     options.chain_length = 1;
-     options.parallel = 1;
-     options.hardware_mapping = "adafruit-hat";  // 필요 시 "regular" 등으로 변경
-     options.pwm_bits = 11;
-     options.brightness = 75;
-     options.gpio_slowdown = 1;  // Pi3 이상이면 1~2
- 
-     rgb_matrix::RGBMatrix *matrix = new rgb_matrix::RGBMatrix(&options);
-     if (!matrix) {
-         fprintf(stderr, "board: RGBMatrix 초기화 실패\n");
-         return 1;
+ static BoardCanvas *matrix_swap(BoardBackend *self, BoardCanvas *back) {
+     MatrixBackend *m = (MatrixBackend *)self;
+     MatrixCanvas *shown = (MatrixCanvas *)back;
+     MatrixCanvas *other = (shown == &m->bufs[0]) ? &m->bufs[1] : &m->bufs[0];
+ 
+     // 돌려받는 FrameCanvas는 처음 한 번은 매트릭스 내부 버퍼이므로 그때 other에 연결
+     other->fc = m->matrix->SwapOnVSync(shown->fc);
+     return &other->base;
+ }
+ 
+ static void matrix_backend_init(MatrixBackend *m, rgb_matrix::RGBMatrix *matrix) {
+     memset(m, 0, sizeof(*m));
+     m->base.back = matrix_back;
+     m->base.swap = matrix_swap;
+     m->matrix = matrix;
+     for (int i = 0; i < 2; i++) {
+         m->bufs[i].base.set_pixel = matrix_set_pixel;
+         m->bufs[i].base.fill = matrix_fill;
      }
-     rgb_matrix::FrameCanvas *canvas = matrix->CreateFrameCanvas();
+     m->bufs[0].fc = matrix->CreateFrameCanvas();
+ }
+ #endif
  
-     // 색상 정의
-     rgb_matrix::Color BLACK = rgb_matrix::Color(0,   0,   0);
-     rgb_matrix::Color WHITE = rgb_matrix::Color(255, 255, 255);
-     rgb_matrix::Color RED   = rgb_matrix::Color(255,   0,   0);
-     rgb_matrix::Color BLUE  = rgb_matrix::Color(0,     0, 255);
-     rgb_matrix::Color GRAY  = rgb_matrix::Color(128, 128, 128);
+ /*
+  * 시그널 스레드: SIGINT/SIGTERM을 sigwait로 받아 렌더 루프에 종료를 알림.
+  * shm 모드에는 입력 EOF가 없어 client의 PR_SET_PDEATHSIG(SIGTERM)가 평소 종료 경로이므로,
+  * 비동기 핸들러에서 exit()하지 않고 락/stdio를 쓰는 정리는 전부 main의 일반 흐름에서 처리
+  */
+ static void *signal_main(void *arg) {
+     const sigset_t *sigs = (const sigset_t *)arg;
+     int signum;
+     if (sigwait(sigs, &signum) != 0) return NULL;
  
-     // 8×8 문자열 보드를 읽어서 그릴 버퍼
-     char board[BOARD_SIZE][BOARD_SIZE + 1];  // 8문자 + NULL
+     pthread_mutex_lock(&mailbox.lock);
+     mailbox.stop = 1;
+     pthread_cond_signal(&mailbox.cond);
+     pthread_mutex_unlock(&mailbox.lock);
+     return NULL;
+ }
  
-     // --------------------------------------------
-     // (2) 무한 루프: stdin으로 8줄씩 읽을 때마다 화면 갱신
-     // --------------------------------------------
+ /*
+  * 스케줄러 통계 출력
+  */
+ static void print_stats(void) {
+     pthread_mutex_lock(&mailbox.lock);
+     unsigned long received = stats.received;
+     unsigned long dropped = stats.dropped;
+     pthread_mutex_unlock(&mailbox.lock);
+ 
+     double lat_avg_ms = stats.rendered ? (double)stats.lat_sum_ns / stats.rendered / 1e6 : 0.0;
+     fprintf(stderr, "board: stats: received %lu, rendered %lu, dropped %lu, swaps %lu, "
+                     "pixels %llu, latency avg %.2f ms / max %.2f ms\n",
+             received, stats.rendered, dropped, stats.swaps, stats.pixels,
+             lat_avg_ms, (double)stats.lat_max_ns / 1e6);
+ }
+ 
+ /*
+  * 종료 시 렌더 단계 지연 요약 출력 및 (--trace가 있으면) Chrome trace JSON 저장.
+  * 렌더/리더 스레드가 모두 멈춘 뒤 main에서 호출 (malloc/stdio를 쓰므로 시그널 경로에서 부르지 않음)
+  */
+ static void finish_trace(void) {
+     trace_print_summary(stderr, "board render stages");
+     if (trace_path && trace_dump_chrome(trace_path) < 0) {
+         perror(trace_path);
+     }
+ }
+ 
+ /*
+  * 받은 보드를 board_bench가 그대로 읽을 수 있는 8줄 텍스트로 기록
+  */
+ static void record_frame(const BoardFrame *frame) {
+     for (int row = 0; row < BOARD_SIZE; row++) {
+         fwrite(frame->cells[row], 1, BOARD_SIZE, record_fp);
+         fputc('\n', record_fp);
+     }
+     fputc('\n', record_fp);
+     fflush(record_fp);
+ }
+ 
+ /*
+  * 공유 메모리 슬롯을 렌더러 입력 프레임으로 변환
+  */
+ static void shm_slot_to_frame(const BoardShmSlot *slot, BoardFrame *frame) {
+     memcpy(frame->cells, slot->cells, BOARD_SHM_CELLS);
+     memset(frame->hl, 0, sizeof(frame->hl));
+     for (int i = 0; i < slot->hl_count; i++) {
+         int idx = slot->hl_cells[i];
+         if (idx < BOARD_SHM_CELLS) frame->hl[idx / BOARD_SIZE][idx % BOARD_SIZE] = 1;
+     }
+     frame->flags = slot->flags;
+     frame->input_ns = slot->sent_ns ? slot->sent_ns : trace_now_ns();
+ }
+ 
+ /*
+  * 공유 메모리 링에서 가장 최신 프레임을 꺼내 frame에 채움.
+  * 그 사이 밀린 프레임은 그리지 않고 *skipped에 더하고, 그중 셀이 최신 프레임과 달라
+  * 보드가 화면에 나오지 못한 것만 *dropped에 더함. 건너뛴 프레임의 flags(BOARD_FRAME_ANIMATE 등)는
+  * 최신 프레임에 OR로 합침. client는 턴마다 ANIMATE 프레임 직후 하이라이트 프레임(flags 0)을
+  * 보내므로, 합치지 않으면 건너뛴 쪽의 페이드 힌트가 사라짐.
+  * 링에서 이미 덮어써진 프레임은 읽을 수 없으므로 개수만 셈.
+  * --record 중이면 건너뛴 프레임도 받은 순서대로 기록 (재생 시퀀스가 받은 시퀀스와 같도록).
+  * 새 프레임이 없으면 eventfd read()에서 잠들었다가 client가 쓰는 즉시 깨어남.
+  * 반환값: 0 = 성공, -1 = eventfd 오류
+  */
+ static int read_shm_frame(BoardFrame *frame, unsigned long *skipped, unsigned long *dropped) {
+     BoardShmSlot slot;
+     uint32_t skipped_flags = 0;
+     // 읽어 둔 건너뛴 프레임의 셀 (최신 프레임을 읽은 뒤 비교)
+     char skipped_cells[BOARD_SHM_SLOTS][BOARD_SHM_CELLS];
+     unsigned long n_skipped_read = 0;
+ 
+     *skipped = 0;
+     *dropped = 0;
      while (1) {
-         // (2-1) 표준입력으로 8줄 읽기
-         for (int i = 0; i < BOARD_SIZE; i++) {
-             if (fgets(board[i], sizeof(board[i]), stdin) == NULL) {
-                 // EOF 또는 에러가 발생한 경우, 잠시 대기 후 재시도
-                 usleep(100000);
-                 i = -1;  // 다시 0부터 읽기
-                 continue;
-             }
-             // 개행(\n) 또는 \r 제거
-             size_t len = strlen(board[i]);
-             if (len > 0 && (board[i][len-1] == '\n' || board[i][len-1] == '\r')) {
-                 board[i][len-1] = '\0';
-                 len--;
+         uint64_t head = board_shm_head(shm);
+ 
+         if (shm_last_seq < head) {
+             // 건너뛸 프레임 중 아직 링에 남아 있는 것 [first, head)의 flags 수집 (및 기록)
+             uint64_t first = head > BOARD_SHM_SLOTS ? head - BOARD_SHM_SLOTS + 1 : 1;
+             if (first <= shm_last_seq) first = shm_last_seq + 1;
+             for (uint64_t seq = first; seq < head; seq++) {
+                 if (!board_shm_read(shm, seq, &slot)) continue;
+                 skipped_flags |= slot.flags;
+                 if (n_skipped_read < BOARD_SHM_SLOTS) {
+                     memcpy(skipped_cells[n_skipped_read++], slot.cells, BOARD_SHM_CELLS);
+                 } else {
+                     (*dropped)++;  // 재시도가 겹쳐 비교용 자리가 없으면 버려진 것으로 셈
+                 }
+                 if (record_fp) {
+                     BoardFrame skipped_frame;
+                     shm_slot_to_frame(&slot, &skipped_frame);
+                     record_frame(&skipped_frame);
+                 }
              }
-             // 만약 길이가 8이 아니면, 해당 줄을 다시 읽기
-             if (len != BOARD_SIZE) {
-                 i = -1;
+             *skipped += head - shm_last_seq - 1;
+             shm_last_seq = head;
+             if (!board_shm_read(shm, head, &slot)) {
+                 // 읽는 도중 더 새 프레임으로 덮어써짐 → 다시 head부터
+                 (*skipped)++;
                  continue;
              }
+             shm_slot_to_frame(&slot, frame);
+             frame->flags |= skipped_flags;
+ 
+             // 읽지 못한(이미 덮어써진) 프레임과 셀이 다른 프레임만 버려진 것으로 셈.
+             // client는 턴마다 같은 셀을 힌트만 바꿔 두 번 보내므로, 그 첫 프레임은 손실이 아님
+             unsigned long unread = *skipped - n_skipped_read - *dropped;
+             *dropped += unread;
+             for (unsigned long i = 0; i < n_skipped_read; i++) {
+                 if (memcmp(skipped_cells[i], slot.cells, BOARD_SHM_CELLS) != 0) (*dropped)++;
+             }
+             return 0;
          }
  
-         // (2-2) 화면을 검은색으로 초기화
-         canvas->Fill(BLACK.r, BLACK.g, BLACK.b);
+         // 새 프레임이 없으면 다음 알림까지 대기 (카운터 값 자체는 쓰지 않음)
+         uint64_t cnt;
+         pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+         ssize_t n = read(event_fd, &cnt, sizeof(cnt));
+         pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+         if (n < 0 && errno == EINTR) continue;
+         if (n != (ssize_t)sizeof(cnt)) {
+             perror("board: eventfd read 실패");
+             return -1;
+         }
+     }
+ }
  
-         // (2-3) 8×8 셀 경계(격자) 그리기 (1픽셀 흰선)
-         for (int k = 0; k <= CELL_COUNT; k++) {
-             int pos = k * CELL_SIZE;  // 0, 8, 16, ..., 64
-             // 수평선 그리기 (y = pos)
-             for (int x = 0; x < MATRIX_COLS; x++) {
-                 canvas->SetPixel(x, pos, WHITE.r, WHITE.g, WHITE.b);
-             }
-             // 수직선 그리기 (x = pos)
-             for (int y = 0; y < MATRIX_ROWS; y++) {
-                 canvas->SetPixel(pos, y, WHITE.r, WHITE.g, WHITE.b);
-             }
+ /*
+  * 리더 스레드: 입력을 받는 대로 우편함의 프레임을 최신 것으로 교체 (latest-wins)
+  */
+ static void *reader_main(void *arg) {
+     (void)arg;
+     BoardFrame frame;
+     trace_set_thread_name("board-reader");
+ 
+     // 종료 시 main이 pthread_cancel로 깨우므로, 취소는 입력을 기다리는 동안에만 허용
+     // (우편함 락이나 --record 파일을 쥔 채 취소되지 않도록)
+     pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+ 
+     while (1) {
+         unsigned long skipped = 0, dropped = 0;
+         int rc;
+         if (shm) {
+             rc = read_shm_frame(&frame, &skipped, &dropped);
+         } else {
+             // 표준입력 8줄 텍스트 모드 (수동 실행/디버깅용). EOF면 입력 쪽이 닫힌 것
+             pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+             rc = board_read_text_frame(stdin, &frame);
+             pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+             frame.input_ns = trace_now_ns();
          }
+         if (rc == 0 && record_fp) record_frame(&frame);
  
-         // (2-4) 각 셀 내부에 기물 또는 장애물 그리기
-         for (int row = 0; row < BOARD_SIZE; row++) {
-             for (int col = 0; col < BOARD_SIZE; col++) {
-                 char c = board[row][col];
-                 rgb_matrix::Color colr = BLACK;
-                 if      (c == 'R') colr = RED;   // 백혈구(빨강)
-                 else if (c == 'B') colr = BLUE;  // 세균(파랑)
-                 else if (c == '#') colr = GRAY;  // 장애물(회색)
-                 else continue;  // '.' 이면 빈칸 → 아무것도 그리지 않음
- 
-                 // 셀 내부 시작 좌표: (col*8+1, row*8+1)
-                 int base_x = col * CELL_SIZE + 1;
-                 int base_y = row * CELL_SIZE + 1;
-                 // 6×6 영역을 colr 색으로 채우기
-                 for (int dx = 0; dx < INNER_SIZE; dx++) {
-                     for (int dy = 0; dy < INNER_SIZE; dy++) {
-                         canvas->SetPixel(base_x + dx, base_y + dy,
-                                          colr.r, colr.g, colr.b);
-                     }
-                 }
+         pthread_mutex_lock(&mailbox.lock);
+         if (rc < 0) {
+             mailbox.eof = 1;
+         } else {
+             stats.received += 1 + skipped;
+             stats.dropped += dropped;
+             if (mailbox.pending) {
+                 // 아직 안 그린 프레임을 덮어씀. 그 프레임의 힌트(페이드 등)는 이어받고,
+                 // 셀이 다를 때만 보드 하나를 잃은 것으로 셈
+                 if (memcmp(mailbox.frame.cells, frame.cells, sizeof(frame.cells)) != 0) stats.dropped++;
+                 frame.flags |= mailbox.frame.flags;
              }
+             mailbox.frame = frame;
+             mailbox.pending = 1;
          }
+         pthread_cond_signal(&mailbox.cond);
+         pthread_mutex_unlock(&mailbox.lock);
  
-         // (2-5) 화면 스왑 (Double Buffering)
-         canvas = matrix->SwapOnVSync(canvas);
+         if (rc < 0) break;
      }
+     return NULL;
+ }
  
-     // 이 지점에는 절대 도달하지 않습니다.
+ int main(int argc, char *argv[]) {
+     int shm_fd = -1;
+     int anim_frames = DEFAULT_ANIM_FRAMES;
+     int animate_all = 0;
+     const char *dump_dir = NULL;
+     const char *record_path = NULL;
+ #ifdef BOARD_NO_MATRIX
+     int use_fb = 1;
+ #else
+     int use_fb = 0;
+ #endif
+ 
+     // 인자 파싱: --shm-fd <N> --event-fd <M> (둘 다 없으면 표준입력 텍스트 모드)
+     for (int i = 1; i < argc; i++) {
+         if      (strcmp(argv[i], "--shm-fd") == 0 && i + 1 < argc)      shm_fd = atoi(argv[++i]);
+         else if (strcmp(argv[i], "--event-fd") == 0 && i + 1 < argc)    event_fd = atoi(argv[++i]);
+         else if (strcmp(argv[i], "--anim-frames") == 0 && i + 1 < argc) anim_frames = atoi(argv[++i]);
+         else if (strcmp(argv[i], "--animate") == 0)                     animate_all = 1;
+         else if (strcmp(argv[i], "--framebuffer") == 0)                 use_fb = 1;
+         else if (strcmp(argv[i], "--dump-dir") == 0 && i + 1 < argc)    dump_dir = argv[++i];
+         else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)      record_path = argv[++i];
+         else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)       trace_path = argv[++i];
+         else {
+             fprintf(stderr, "Usage: %s [--shm-fd <N> --event-fd <M>] [--animate] [--anim-frames <N>]\n"
+                             "          [--framebuffer] [--dump-dir <DIR>] [--record <FILE>] [--trace <FILE>]\n",
+                     argv[0]);
+             return 1;
+         }
+     }
+     if ((shm_fd < 0) != (event_fd < 0)) {
+         fprintf(stderr, "board: --shm-fd와 --event-fd는 함께 지정해야 합니다\n");
+         return 1;
+     }
+     if (dump_dir) use_fb = 1;
+     if (record_path) {
+         record_fp = fopen(record_path, "w");
+         if (!record_fp) {
+             perror(record_path);
+             return 1;
+         }
+     }
+ 
+     // SIGINT, SIGTERM은 모든 스레드(매트릭스 라이브러리 스레드 포함)에서 막고 시그널 스레드만 받음
+     static sigset_t sigs;
+     sigemptyset(&sigs);
+     sigaddset(&sigs, SIGINT);
+     sigaddset(&sigs, SIGTERM);
+     pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+     pthread_t sig_thread;
+     if (pthread_create(&sig_thread, NULL, signal_main, &sigs) != 0) {
+         fprintf(stderr, "board: 시그널 스레드 생성 실패\n");
+         return 1;
+     }
+     pthread_detach(sig_thread);
+ 
+     // 공유 메모리 프레임 링 매핑 (읽기 전용) 및 프로토콜 버전 확인
+     if (shm_fd >= 0) {
+         void *p = mmap(NULL, sizeof(BoardShm), PROT_READ, MAP_SHARED, shm_fd, 0);
+         if (p == MAP_FAILED) {
+             perror("board: 공유 메모리 mmap 실패");
+             return 1;
+         }
+         shm = (const BoardShm *)p;
+         if (!board_shm_compatible(shm)) {
+             fprintf(stderr, "board: 프레임 프로토콜 불일치 (magic 0x%08x, version %u)\n",
+                     (unsigned)shm->magic, (unsigned)shm->version);
+             return 1;
+         }
+         close(shm_fd);  // 매핑은 fd를 닫아도 유지됨
+     }
+ 
+     // --------------------------------------------
+     // (1) 캔버스 백엔드 초기화 (rpi-rgb-led-matrix 또는 메모리 프레임버퍼)
+     // --------------------------------------------
+     static BoardFb fb;
+     BoardBackend *backend = NULL;
+ #ifndef BOARD_NO_MATRIX
+     static MatrixBackend mb;
+     rgb_matrix::RGBMatrix *matrix = NULL;
+     if (!use_fb) {
+         rgb_matrix::RGBMatrix::Options options;
+         options.rows = MATRIX_ROWS;
+         options.cols = MATRIX_COLS;
+         options.chain_length = 1;
+         options.parallel = 1;
+         options.hardware_mapping = "adafruit-hat";  // 필요 시 "regular" 등으로 변경
+         options.pwm_bits = 11;
+         options.brightness = 75;
+         options.gpio_slowdown = 1;  // Pi3 이상이면 1~2
+ 
+         matrix = new rgb_matrix::RGBMatrix(&options);
+         if (!matrix) {
+             fprintf(stderr, "board: RGBMatrix 초기화 실패\n");
+             return 1;
+         }
+         matrix_backend_init(&mb, matrix);
+         backend = &mb.base;
+     }
+ #endif
+     if (use_fb) {
+         board_fb_init(&fb, dump_dir, FB_VSYNC_HZ);
+         backend = &fb.base;
+     }
+     BoardCanvas *canvas = backend->back(backend);
+ 
+     // 모든 셀은 검정(빈칸)에서 시작
+     static BoardRenderer renderer;
+     board_renderer_init(&renderer, anim_frames, animate_all);
+ 
+     // --------------------------------------------
+     // (2) 리더 스레드 시작 (입력 수신은 전부 이 스레드가 담당)
+     // --------------------------------------------
+     trace_set_thread_name("board-render");
+     pthread_t reader;
+     if (pthread_create(&reader, NULL, reader_main, NULL) != 0) {
+         fprintf(stderr, "board: 리더 스레드 생성 실패\n");
+         return 1;
+     }
+ 
+     // --------------------------------------------
+     // (3) 렌더 루프: 새 프레임이나 진행 중인 애니메이션이 있을 때만 vsync 주기로 그림
+     // --------------------------------------------
+     int animating = 0;
+     while (1) {
+         // (3-1) 우편함에서 최신 프레임 가져오기 (할 일이 없으면 잠듦)
+         BoardFrame frame;
+         int have_new = 0;
+         frame.input_ns = 0;
+         pthread_mutex_lock(&mailbox.lock);
+         while (!mailbox.pending && !mailbox.eof && !animating && !mailbox.stop) {
+             pthread_cond_wait(&mailbox.cond, &mailbox.lock);
+         }
+         if (mailbox.stop) {
+             // SIGINT/SIGTERM: 남은 프레임/애니메이션은 버리고 종료
+             pthread_mutex_unlock(&mailbox.lock);
+             break;
+         }
+         if (mailbox.pending) {
+             frame = mailbox.frame;
+             mailbox.pending = 0;
+             have_new = 1;
+         } else if (!animating) {
+             // 입력이 끝났고 그릴 것도 남지 않음
+             pthread_mutex_unlock(&mailbox.lock);
+             break;
+         }
+         pthread_mutex_unlock(&mailbox.lock);
+         // 시각은 모두 trace_now_ns() (client의 sent_ns와 같은 CLOCK_MONOTONIC)
+         uint64_t t_picked = trace_now_ns();
+         if (have_new) trace_span("led.queue", frame.input_ns, t_picked);
+ 
+         // (3-2) back 버퍼에 이번 프레임 그리기 (바뀐 셀만)
+         if (have_new) board_renderer_apply(&renderer, &frame);
+         int dirty;
+         int pixels = board_renderer_draw(&renderer, canvas, &dirty, &animating);
+         uint64_t t_drawn = trace_now_ns();
+         trace_span("led.draw", t_picked, t_drawn);
+ 
+         // (3-3) 화면 스왑 (Double Buffering). vsync까지 블록되므로 렌더 주기가 패널 갱신에 맞춰짐
+         //       돌려받는 버퍼는 두 프레임 전 상태이며, 다음 draw에서 그 상태와 비교해 갱신됨
+         canvas = backend->swap(backend, canvas);
+         uint64_t now = trace_now_ns();
+         trace_span("led.swap", t_drawn, now);
+         stats.swaps++;
+         stats.pixels += pixels;
+ 
+         // (3-4) 입력 → 화면 반영 지연 기록
+         if (have_new) {
+             trace_span("led.input_to_photon", frame.input_ns, now);
+             uint64_t lat = now > frame.input_ns ? now - frame.input_ns : 0;
+             stats.rendered++;
+             stats.lat_sum_ns += lat;
+             if (lat > stats.lat_max_ns) stats.lat_max_ns = lat;
+             fprintf(stderr, "board: frame %lu: %d cells, %d pixels written, latency %.2f ms\n",
+                     stats.rendered, dirty, pixels, (double)lat / 1e6);
+             if (stats.rendered % STATS_INTERVAL == 0) print_stats();
+         }
+     }
+ 
+     // 입력이 닫히거나 (stdin 모드) 시그널을 받으면 (client 종료 등) 데몬도 종료.
+     // 리더가 아직 입력을 기다리는 중이면 취소해서 깨움 (이미 끝났으면 아무 일도 없음)
+     pthread_cancel(reader);
+     pthread_join(reader, NULL);
+     print_stats();
+     finish_trace();
+ #ifndef BOARD_NO_MATRIX
+     delete matrix;
+ #endif
+     if (record_fp) fclose(record_fp);
      return 0;
  }
- 
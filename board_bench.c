@@ -0,0 +1,209 @@
+/*
+ * board_bench.c
+ *
+ * 하드웨어 없이 board 데몬의 그리기 경로를 재생/측정하는 벤치마크.
+ * 기록된 보드 시퀀스(8줄 텍스트 보드 반복, `board --record`로 생성)를
+ * board_render.c + 메모리 프레임버퍼(board_fb.c)로 그리고
+ *   - frames/sec, 프레임당 µs (평균/p50/p99/최대), 프레임당 쓴 픽셀 수를 출력하고
+ *   - 보드마다 전환이 끝난 화면을 골든 PPM과 픽셀 단위로 비교합니다.
+ *
+ * 컴파일 예:
+ *   gcc -O2 -o board_bench board_bench.c board_render.c board_fb.c
+ *
+ * 실행 예:
+ *   ./board_bench game.txt --iterations 200
+ *   ./board_bench game.txt --full --golden golden/ --update-golden   (전체 다시 그리기로 골든 생성)
+ *   ./board_bench game.txt --golden golden/                          (증분 렌더링 결과 검증)
+ *
+ * 골든 파일: <DIR>/board_NNNN.ppm (NNNN = 시퀀스 안의 보드 번호, 1부터)
+ * 저장소에 기록된 한 게임(testdata/board_seq.txt)과 그 골든(testdata/golden/)이 있으며,
+ * testdata/check_board_golden.sh 가 빌드부터 비교까지 한 번에 실행합니다.
+ * 종료 코드: 0 = 성공, 1 = 골든 불일치/누락, 2 = 사용법/입력 오류
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "board_render.h"
+#include "board_fb.h"
+
+#define DEFAULT_ITERATIONS 100
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s <sequence.txt> [--iterations <N>] [--animate] [--anim-frames <N>]\n"
+                    "          [--full] [--golden <DIR>] [--update-golden]\n", prog);
+}
+
+/*
+ * 시퀀스 파일의 보드를 전부 읽음. 반환값: 보드 수 (*out은 호출한 쪽에서 free)
+ */
+static int load_sequence(const char *path, BoardFrame **out) {
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        perror(path);
+        return -1;
+    }
+    int n = 0, cap = 64;
+    BoardFrame *frames = (BoardFrame *)malloc(sizeof(BoardFrame) * cap);
+    BoardFrame frame;
+    while (board_read_text_frame(fp, &frame) == 0) {
+        if (n == cap) {
+            cap *= 2;
+            frames = (BoardFrame *)realloc(frames, sizeof(BoardFrame) * cap);
+        }
+        frames[n++] = frame;
+    }
+    fclose(fp);
+    *out = frames;
+    return n;
+}
+
+/*
+ * 표시 중인 화면을 골든 PPM과 비교 (update면 골든을 새로 씀). 일치/저장 성공이면 0
+ */
+static int check_golden(const char *dir, int index, const uint8_t *px, int update) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/board_%04d.ppm", dir, index);
+
+    if (update) {
+        if (board_fb_write_ppm(path, px) < 0) {
+            perror(path);
+            return -1;
+        }
+        return 0;
+    }
+
+    static uint8_t want[BOARD_FB_BYTES];
+    if (board_fb_read_ppm(path, want) < 0) {
+        fprintf(stderr, "board_bench: 골든 파일을 읽을 수 없음: %s (--update-golden으로 생성)\n", path);
+        return -1;
+    }
+    for (int i = 0; i < BOARD_FB_BYTES; i += 3) {
+        if (memcmp(&px[i], &want[i], 3) != 0) {
+            int x = (i / 3) % MATRIX_COLS, y = (i / 3) / MATRIX_COLS;
+            fprintf(stderr, "board_bench: 보드 %d 불일치: 픽셀 (%d,%d) = (%d,%d,%d), 골든 (%d,%d,%d)\n",
+                    index, x, y, px[i], px[i+1], px[i+2], want[i], want[i+1], want[i+2]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *seq_path = NULL;
+    const char *golden_dir = NULL;
+    int update_golden = 0;
+    int iterations = DEFAULT_ITERATIONS;
+    int anim_frames = 0;
+    int animate_all = 0;
+    int full_redraw = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if      (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)  iterations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--anim-frames") == 0 && i + 1 < argc) anim_frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--animate") == 0)                     animate_all = 1;
+        else if (strcmp(argv[i], "--full") == 0)                        full_redraw = 1;
+        else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)      golden_dir = argv[++i];
+        else if (strcmp(argv[i], "--update-golden") == 0)               update_golden = 1;
+        else if (argv[i][0] != '-' && !seq_path)                        seq_path = argv[i];
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!seq_path || iterations <= 0 || (update_golden && !golden_dir)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (animate_all && anim_frames == 0) anim_frames = 24;
+
+    BoardFrame *frames = NULL;
+    int n_frames = load_sequence(seq_path, &frames);
+    if (n_frames <= 0) {
+        fprintf(stderr, "board_bench: %s 에 보드가 없음\n", seq_path);
+        free(frames);
+        return 2;
+    }
+
+    static BoardFb fb;
+    static BoardRenderer renderer;
+    board_fb_init(&fb, NULL, 0);   // 덤프/대기 없이 그리기 비용만 측정
+    board_renderer_init(&renderer, anim_frames, animate_all);
+    BoardCanvas *canvas = fb.base.back(&fb.base);
+
+    // 프레임(= draw + swap 한 번)별 소요 시간
+    size_t cap = (size_t)n_frames * iterations, n_samples = 0;
+    uint64_t *samples = (uint64_t *)malloc(sizeof(uint64_t) * cap);
+    unsigned long long pixels = 0;
+    int golden_failures = 0;
+
+    uint64_t start = now_ns();
+    for (int it = 0; it < iterations; it++) {
+        for (int f = 0; f < n_frames; f++) {
+            board_renderer_apply(&renderer, &frames[f]);
+            int animating;
+            do {
+                if (full_redraw) board_renderer_invalidate(&renderer);
+                int dirty;
+                uint64_t t0 = now_ns();
+                pixels += board_renderer_draw(&renderer, canvas, &dirty, &animating);
+                canvas = fb.base.swap(&fb.base, canvas);
+                uint64_t t1 = now_ns();
+
+                if (n_samples == cap) {
+                    cap *= 2;
+                    samples = (uint64_t *)realloc(samples, sizeof(uint64_t) * cap);
+                }
+                samples[n_samples++] = t1 - t0;
+            } while (animating);
+
+            // 첫 번째 재생에서만 골든 비교 (측정 구간에서 제외)
+            if (it == 0 && golden_dir) {
+                uint64_t g0 = now_ns();
+                if (check_golden(golden_dir, f + 1, board_fb_front(&fb), update_golden) < 0) {
+                    golden_failures++;
+                }
+                start += now_ns() - g0;
+            }
+        }
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    qsort(samples, n_samples, sizeof(uint64_t), cmp_u64);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n_samples; i++) sum += samples[i];
+
+    printf("board_bench: %s: %d boards x %d iterations, %zu frames (%s%s)\n",
+           seq_path, n_frames, iterations, n_samples,
+           full_redraw ? "full redraw" : "incremental",
+           anim_frames > 0 ? ", animated" : "");
+    printf("  %.1f frames/sec, %.3f us/frame avg, p50 %.3f us, p99 %.3f us, max %.3f us\n",
+           n_samples / (elapsed / 1e9),
+           (double)sum / n_samples / 1e3,
+           samples[n_samples / 2] / 1e3,
+           samples[(size_t)((n_samples - 1) * 0.99)] / 1e3,
+           samples[n_samples - 1] / 1e3);
+    printf("  %.1f pixels written/frame\n", (double)pixels / n_samples);
+    if (golden_dir) {
+        if (update_golden) printf("  golden: %d images written to %s\n", n_frames, golden_dir);
+        else printf("  golden: %d/%d boards match\n", n_frames - golden_failures, n_frames);
+    }
+
+    free(samples);
+    free(frames);
+    return golden_failures ? 1 : 0;
+}
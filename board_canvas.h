@@ -0,0 +1,51 @@
+/*
+ * board_canvas.h
+ *
+ * 보드 렌더러가 그림을 그리는 대상(캔버스)과 더블 버퍼 백엔드의 추상 인터페이스.
+ *
+ *   - LED 매트릭스 백엔드: board.c (rpi-rgb-led-matrix의 FrameCanvas + SwapOnVSync)
+ *   - 메모리 프레임버퍼 백엔드: board_fb.c (하드웨어 없이 테스트/벤치마크/PPM 덤프)
+ *
+ * 구현은 각 백엔드 구조체의 첫 멤버로 BoardCanvas / BoardBackend를 두고
+ * 함수 포인터를 채웁니다.
+ *
+ * 렌더링/프레임 전달/추적 공용 소스(board_canvas.h, board_render.*, board_fb.*, board_shm.h,
+ * trace.*)는 board 데몬(g++)과 client, board_bench(gcc) 양쪽에서 컴파일되므로
+ * C/C++ 공통 문법만 사용합니다.
+ */
+
+#ifndef BOARD_CANVAS_H
+#define BOARD_CANVAS_H
+
+#include <stdint.h>
+
+// LED 매트릭스 픽셀 크기
+#define MATRIX_ROWS 64
+#define MATRIX_COLS 64
+
+typedef struct {
+    uint8_t r, g, b;
+} BoardColor;
+
+typedef struct BoardCanvas BoardCanvas;
+typedef struct BoardBackend BoardBackend;
+
+/*
+ * 버퍼 하나. 같은 버퍼는 항상 같은 BoardCanvas 포인터로 식별됩니다.
+ */
+struct BoardCanvas {
+    void (*set_pixel)(BoardCanvas *self, int x, int y, uint8_t r, uint8_t g, uint8_t b);
+    void (*fill)(BoardCanvas *self, uint8_t r, uint8_t g, uint8_t b);
+};
+
+/*
+ * 더블 버퍼 백엔드
+ *   back(): 처음 그릴 back 버퍼
+ *   swap(): back을 화면에 표시하고(필요하면 vsync까지 대기) 다음에 그릴 back 버퍼를 반환
+ */
+struct BoardBackend {
+    BoardCanvas *(*back)(BoardBackend *self);
+    BoardCanvas *(*swap)(BoardBackend *self, BoardCanvas *back);
+};
+
+#endif // BOARD_CANVAS_H
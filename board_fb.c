@@ -0,0 +1,115 @@
+/*
+ * board_fb.c
+ *
+ * 메모리 RGB 프레임버퍼 백엔드 구현 (board_fb.h 참고).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "board_fb.h"
+
+static void fb_set_pixel(BoardCanvas *self, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+    BoardFbCanvas *c = (BoardFbCanvas *)self;
+    // 패널 밖 좌표는 무시 (rpi-rgb-led-matrix의 SetPixel과 같은 동작)
+    if (x < 0 || x >= MATRIX_COLS || y < 0 || y >= MATRIX_ROWS) return;
+    c->px[y][x][0] = r;
+    c->px[y][x][1] = g;
+    c->px[y][x][2] = b;
+}
+
+static void fb_fill(BoardCanvas *self, uint8_t r, uint8_t g, uint8_t b) {
+    BoardFbCanvas *c = (BoardFbCanvas *)self;
+    for (int y = 0; y < MATRIX_ROWS; y++) {
+        for (int x = 0; x < MATRIX_COLS; x++) {
+            c->px[y][x][0] = r;
+            c->px[y][x][1] = g;
+            c->px[y][x][2] = b;
+        }
+    }
+}
+
+static uint64_t fb_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static BoardCanvas *fb_back(BoardBackend *self) {
+    BoardFb *fb = (BoardFb *)self;
+    return &fb->bufs[1 - fb->front].base;
+}
+
+static BoardCanvas *fb_swap(BoardBackend *self, BoardCanvas *back) {
+    BoardFb *fb = (BoardFb *)self;
+
+    // 다음 vsync 시각까지 대기 (늦었으면 기준 시각만 다시 잡음)
+    if (fb->vsync_hz > 0) {
+        uint64_t period = 1000000000ull / (uint64_t)fb->vsync_hz;
+        uint64_t now = fb_now_ns();
+        if (fb->next_vsync_ns == 0 || fb->next_vsync_ns + period < now) {
+            fb->next_vsync_ns = now + period;
+        }
+        struct timespec ts;
+        ts.tv_sec = (time_t)(fb->next_vsync_ns / 1000000000ull);
+        ts.tv_nsec = (long)(fb->next_vsync_ns % 1000000000ull);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        }
+        fb->next_vsync_ns += period;
+    }
+
+    fb->front = (back == &fb->bufs[0].base) ? 0 : 1;
+    fb->swaps++;
+
+    if (fb->dump_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/frame_%06lu.ppm", fb->dump_dir, fb->swaps);
+        if (board_fb_write_ppm(path, board_fb_front(fb)) < 0) {
+            perror(path);
+        }
+    }
+    return &fb->bufs[1 - fb->front].base;
+}
+
+void board_fb_init(BoardFb *fb, const char *dump_dir, int vsync_hz) {
+    memset(fb, 0, sizeof(*fb));
+    fb->base.back = fb_back;
+    fb->base.swap = fb_swap;
+    for (int i = 0; i < 2; i++) {
+        fb->bufs[i].base.set_pixel = fb_set_pixel;
+        fb->bufs[i].base.fill = fb_fill;
+    }
+    fb->front = 0;
+    fb->dump_dir = dump_dir;
+    fb->vsync_hz = vsync_hz;
+}
+
+const uint8_t *board_fb_front(const BoardFb *fb) {
+    return &fb->bufs[fb->front].px[0][0][0];
+}
+
+int board_fb_write_ppm(const char *path, const uint8_t *px) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp) return -1;
+    fprintf(fp, "P6\n%d %d\n255\n", MATRIX_COLS, MATRIX_ROWS);
+    size_t n = fwrite(px, 1, BOARD_FB_BYTES, fp);
+    if (fclose(fp) != 0 || n != BOARD_FB_BYTES) return -1;
+    return 0;
+}
+
+int board_fb_read_ppm(const char *path, uint8_t *px) {
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return -1;
+    int w, h, maxval;
+    // 헤더: "P6 <w> <h> <maxval>" 다음 공백 한 글자 뒤부터 픽셀
+    if (fscanf(fp, "P6 %d %d %d", &w, &h, &maxval) != 3 ||
+        w != MATRIX_COLS || h != MATRIX_ROWS || maxval != 255 || fgetc(fp) == EOF) {
+        fclose(fp);
+        return -1;
+    }
+    size_t n = fread(px, 1, BOARD_FB_BYTES, fp);
+    fclose(fp);
+    return n == BOARD_FB_BYTES ? 0 : -1;
+}
@@ -0,0 +1,51 @@
+/*
+ * board_fb.h
+ *
+ * 하드웨어 없이 쓰는 메모리 RGB 프레임버퍼 백엔드 (BoardBackend 구현).
+ *
+ *   - 64×64×RGB 버퍼 두 개를 번갈아 쓰는 더블 버퍼
+ *   - swap 때마다 화면에 "표시된" 버퍼를 PPM(P6) 파일로 덤프할 수 있음
+ *   - vsync_hz > 0 이면 swap이 그 주기에 맞춰 대기 (패널 갱신 흉내)
+ */
+
+#ifndef BOARD_FB_H
+#define BOARD_FB_H
+
+#include <stdint.h>
+
+#include "board_canvas.h"
+
+#define BOARD_FB_BYTES (MATRIX_ROWS * MATRIX_COLS * 3)
+
+typedef struct {
+    BoardCanvas base;                            // 반드시 첫 멤버
+    uint8_t px[MATRIX_ROWS][MATRIX_COLS][3];
+} BoardFbCanvas;
+
+typedef struct {
+    BoardBackend base;                           // 반드시 첫 멤버
+    BoardFbCanvas bufs[2];
+    int front;                                   // 표시 중인 버퍼 인덱스
+    const char *dump_dir;                        // NULL이면 덤프 안 함
+    int vsync_hz;                                // 0이면 대기 없음
+    uint64_t next_vsync_ns;
+    unsigned long swaps;
+} BoardFb;
+
+/*
+ * 두 버퍼를 검정으로 초기화. dump_dir이 있으면 swap마다 <dump_dir>/frame_NNNNNN.ppm 저장
+ */
+void board_fb_init(BoardFb *fb, const char *dump_dir, int vsync_hz);
+
+/*
+ * 현재 표시 중인 버퍼의 픽셀 (BOARD_FB_BYTES 바이트, 행 우선 RGB)
+ */
+const uint8_t *board_fb_front(const BoardFb *fb);
+
+/*
+ * 64×64 RGB 픽셀을 P6 PPM으로 저장 / 읽기. 성공하면 0, 실패하면 -1
+ */
+int board_fb_write_ppm(const char *path, const uint8_t *px);
+int board_fb_read_ppm(const char *path, uint8_t *px);
+
+#endif // BOARD_FB_H
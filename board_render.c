@@ -0,0 +1,218 @@
+/*
+ * board_render.c
+ *
+ * 8×8 보드 → 64×64 캔버스 렌더러 구현 (board_render.h 참고).
+ */
+
+#include <string.h>
+
+#include "board_render.h"
+#include "board_shm.h"   // BOARD_FRAME_ANIMATE
+
+// 색상 정의
+static const BoardColor BLACK  = {   0,   0,   0 };
+static const BoardColor WHITE  = { 255, 255, 255 };
+static const BoardColor RED    = { 255,   0,   0 };
+static const BoardColor BLUE   = {   0,   0, 255 };
+static const BoardColor GRAY   = { 128, 128, 128 };
+static const BoardColor YELLOW = { 255, 200,   0 };  // 하이라이트 테두리
+
+/*
+ * 기물 문자 → 셀 내부 색상 ('.' 및 알 수 없는 문자는 빈칸으로 보고 검정)
+ */
+static BoardColor cell_color(char c) {
+    if      (c == 'R') return RED;   // 백혈구(빨강)
+    else if (c == 'B') return BLUE;  // 세균(파랑)
+    else if (c == '#') return GRAY;  // 장애물(회색)
+    return BLACK;
+}
+
+static int same_color(BoardColor a, BoardColor b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/*
+ * 셀의 현재 표시 색 (전환 중이면 from → to 선형 보간)
+ */
+static BoardColor anim_color(const BoardRenderer *r, const BoardCellAnim *a) {
+    if (a->step >= r->anim_frames) return a->to;
+    int t = a->step, n = r->anim_frames;
+    BoardColor c;
+    c.r = (uint8_t)(a->from.r + (a->to.r - a->from.r) * t / n);
+    c.g = (uint8_t)(a->from.g + (a->to.g - a->from.g) * t / n);
+    c.b = (uint8_t)(a->from.b + (a->to.b - a->from.b) * t / n);
+    return c;
+}
+
+/*
+ * (row, col) 셀 내부 6×6 영역을 colr로 칠하고, 쓴 픽셀 수를 반환
+ * 하이라이트 셀은 6×6의 바깥 1픽셀을 노란색 테두리로 칠함
+ * (격자선은 건드리지 않으므로 셀 단위로 독립적으로 다시 그릴 수 있음)
+ */
+static int paint_cell(BoardCanvas *canvas, int row, int col, BoardColor colr, int hl) {
+    // 셀 내부 시작 좌표: (col*8+1, row*8+1)
+    int base_x = col * CELL_SIZE + 1;
+    int base_y = row * CELL_SIZE + 1;
+    for (int dx = 0; dx < INNER_SIZE; dx++) {
+        for (int dy = 0; dy < INNER_SIZE; dy++) {
+            int edge = (dx == 0 || dy == 0 || dx == INNER_SIZE - 1 || dy == INNER_SIZE - 1);
+            BoardColor px = (hl && edge) ? YELLOW : colr;
+            canvas->set_pixel(canvas, base_x + dx, base_y + dy, px.r, px.g, px.b);
+        }
+    }
+    return INNER_SIZE * INNER_SIZE;
+}
+
+/*
+ * 버퍼 전체를 처음부터 그림 (해당 버퍼를 처음 받았을 때만 사용). 쓴 픽셀 수를 반환
+ */
+static int draw_full_board(BoardCanvas *canvas,
+                           BoardColor color[BOARD_SIZE][BOARD_SIZE],
+                           unsigned char hl[BOARD_SIZE][BOARD_SIZE]) {
+    int pixels = 0;
+
+    // 화면을 검은색으로 초기화
+    canvas->fill(canvas, BLACK.r, BLACK.g, BLACK.b);
+    pixels += MATRIX_ROWS * MATRIX_COLS;
+
+    // 8×8 셀 경계(격자) 그리기 (1픽셀 흰선)
+    // pos = 64 인 마지막 선은 패널 밖이므로 그리지 않음
+    for (int k = 0; k < CELL_COUNT; k++) {
+        int pos = k * CELL_SIZE;  // 0, 8, 16, ..., 56
+        // 수평선 그리기 (y = pos)
+        for (int x = 0; x < MATRIX_COLS; x++) {
+            canvas->set_pixel(canvas, x, pos, WHITE.r, WHITE.g, WHITE.b);
+        }
+        // 수직선 그리기 (x = pos)
+        for (int y = 0; y < MATRIX_ROWS; y++) {
+            canvas->set_pixel(canvas, pos, y, WHITE.r, WHITE.g, WHITE.b);
+        }
+        pixels += MATRIX_COLS + MATRIX_ROWS;
+    }
+
+    // 각 셀 내부 그리기 (하이라이트 없는 검정 셀은 fill로 이미 칠해져 있음)
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            if (same_color(color[row][col], BLACK) && !hl[row][col]) continue;
+            pixels += paint_cell(canvas, row, col, color[row][col], hl[row][col]);
+        }
+    }
+    return pixels;
+}
+
+/*
+ * canvas에 해당하는 버퍼 상태를 찾음. 처음 보는 버퍼면 빈 슬롯을 배정하고 *is_new = 1
+ */
+static BoardBufferState *buffer_state_for(BoardRenderer *r, BoardCanvas *canvas, int *is_new) {
+    *is_new = 0;
+    for (int i = 0; i < RENDER_BUFFERS; i++) {
+        if (r->buffers[i].canvas == canvas) return &r->buffers[i];
+    }
+    for (int i = 0; i < RENDER_BUFFERS; i++) {
+        if (r->buffers[i].canvas == NULL) {
+            r->buffers[i].canvas = canvas;
+            *is_new = 1;
+            return &r->buffers[i];
+        }
+    }
+    // 버퍼는 두 개뿐이므로 여기 올 일은 없지만, 만약을 위해 0번 슬롯을 재사용
+    r->buffers[0].canvas = canvas;
+    *is_new = 1;
+    return &r->buffers[0];
+}
+
+void board_renderer_init(BoardRenderer *r, int anim_frames, int animate_all) {
+    memset(r, 0, sizeof(*r));
+    r->anim_frames = anim_frames < 0 ? 0 : anim_frames;
+    r->animate_all = animate_all;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            r->cells[row][col].from = BLACK;
+            r->cells[row][col].to = BLACK;
+            r->cells[row][col].step = r->anim_frames;
+        }
+    }
+}
+
+void board_renderer_invalidate(BoardRenderer *r) {
+    memset(r->buffers, 0, sizeof(r->buffers));
+}
+
+void board_renderer_apply(BoardRenderer *r, const BoardFrame *frame) {
+    // 애니메이션이 켜져 있으면 바뀐 셀은 "지금 보이는 색"에서 새 색으로 페이드 시작
+    int animate = r->anim_frames > 0 && (r->animate_all || (frame->flags & BOARD_FRAME_ANIMATE));
+
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            BoardCellAnim *a = &r->cells[row][col];
+            BoardColor target = cell_color(frame->cells[row][col]);
+            if (same_color(target, a->to)) continue;
+            a->from = animate ? anim_color(r, a) : target;
+            a->to = target;
+            a->step = animate ? 0 : r->anim_frames;
+        }
+    }
+    memcpy(r->hl, frame->hl, sizeof(r->hl));
+}
+
+int board_renderer_draw(BoardRenderer *r, BoardCanvas *canvas, int *dirty, int *animating) {
+    BoardColor color[BOARD_SIZE][BOARD_SIZE];
+
+    *animating = 0;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            BoardCellAnim *a = &r->cells[row][col];
+            if (a->step < r->anim_frames) a->step++;
+            if (a->step < r->anim_frames) *animating = 1;
+            color[row][col] = anim_color(r, a);
+        }
+    }
+
+    int is_new;
+    BoardBufferState *st = buffer_state_for(r, canvas, &is_new);
+    int pixels = 0;
+    *dirty = 0;
+    if (is_new) {
+        // 처음 받은 버퍼: 격자 포함 전체 그리기
+        pixels = draw_full_board(canvas, color, r->hl);
+        *dirty = BOARD_SIZE * BOARD_SIZE;
+    } else {
+        // 이 버퍼에 마지막으로 그린 색과 다른 셀만 다시 칠함
+        for (int row = 0; row < BOARD_SIZE; row++) {
+            for (int col = 0; col < BOARD_SIZE; col++) {
+                if (same_color(st->color[row][col], color[row][col]) &&
+                    st->hl[row][col] == r->hl[row][col]) continue;
+                pixels += paint_cell(canvas, row, col, color[row][col], r->hl[row][col]);
+                (*dirty)++;
+            }
+        }
+    }
+    memcpy(st->color, color, sizeof(st->color));
+    memcpy(st->hl, r->hl, sizeof(st->hl));
+    return pixels;
+}
+
+int board_read_text_frame(FILE *fp, BoardFrame *frame) {
+    for (int i = 0; i < BOARD_SIZE; i++) {
+        // 줄 버퍼는 개행("\r\n")까지 담을 수 있도록 넉넉하게 잡음
+        char line[64];
+        if (fgets(line, sizeof(line), fp) == NULL) {
+            return -1;
+        }
+        // 개행(\n) 또는 \r 제거
+        size_t len = strlen(line);
+        while (len > 0 && (line[len-1] == '\n' || line[len-1] == '\r')) {
+            line[--len] = '\0';
+        }
+        // 만약 길이가 8이 아니면, 해당 줄을 다시 읽기 (빈 줄 구분자도 여기서 걸러짐)
+        if (len != BOARD_SIZE) {
+            i = -1;
+            continue;
+        }
+        memcpy(frame->cells[i], line, BOARD_SIZE);
+    }
+    memset(frame->hl, 0, sizeof(frame->hl));
+    frame->flags = 0;
+    frame->input_ns = 0;
+    return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * board_render.h
+ *
+ * 8×8 보드를 64×64 캔버스에 그리는 렌더러 (board 데몬과 board_bench가 공유).
+ *
+ *   - 셀마다 색 전환(페이드) 상태를 두고, board_renderer_draw()가 호출될 때마다 한 프레임 진행
+ *   - 버퍼(BoardCanvas)마다 마지막으로 그린 색을 기억해 두었다가 바뀐 셀만 다시 칠함
+ *     (더블 버퍼는 두 버퍼를 번갈아 받으므로 "그 버퍼에 마지막으로 그린 상태"와 비교)
+ */
+
+#ifndef BOARD_RENDER_H
+#define BOARD_RENDER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "board_canvas.h"
+
+// 보드 크기: 8×8
+#define BOARD_SIZE 8
+
+// 셀 하나의 크기 (8)
+#define CELL_COUNT BOARD_SIZE
+#define CELL_SIZE (MATRIX_ROWS / CELL_COUNT)   // = 8
+#define INNER_SIZE (CELL_SIZE - 2)             // = 6 (테두리 1픽셀 마진)
+
+// 렌더 버퍼 수 (더블 버퍼)
+#define RENDER_BUFFERS 2
+
+/*
+ * 화면에 그릴 한 프레임 (입력 방식과 무관하게 이 형태로 변환해서 그림)
+ */
+typedef struct {
+    char cells[BOARD_SIZE][BOARD_SIZE];          // 'R', 'B', '#', '.'
+    unsigned char hl[BOARD_SIZE][BOARD_SIZE];    // 1이면 하이라이트 (직전 수의 출발/도착 칸 등)
+    unsigned int flags;                          // BOARD_FRAME_* 힌트 (board_shm.h)
+    uint64_t input_ns;                           // 입력 시각 (client 전송 시각 또는 수신 시각)
+} BoardFrame;
+
+/*
+ * 버퍼 하나에 마지막으로 그려 둔 셀 색상
+ */
+typedef struct {
+    BoardCanvas *canvas;                         // NULL이면 빈 슬롯
+    BoardColor color[BOARD_SIZE][BOARD_SIZE];
+    unsigned char hl[BOARD_SIZE][BOARD_SIZE];
+} BoardBufferState;
+
+/*
+ * 셀 하나의 색 전환 상태. step이 anim_frames 이상이면 전환이 끝나 to 색으로 고정
+ */
+typedef struct {
+    BoardColor from, to;
+    int step;
+} BoardCellAnim;
+
+typedef struct {
+    BoardBufferState buffers[RENDER_BUFFERS];
+    BoardCellAnim cells[BOARD_SIZE][BOARD_SIZE];
+    unsigned char hl[BOARD_SIZE][BOARD_SIZE];
+    int anim_frames;                             // 페이드 길이 (0이면 애니메이션 끔)
+    int animate_all;                             // 1이면 힌트와 무관하게 모든 프레임 페이드
+} BoardRenderer;
+
+/*
+ * 모든 셀이 검정(빈칸)인 상태로 초기화
+ */
+void board_renderer_init(BoardRenderer *r, int anim_frames, int animate_all);
+
+/*
+ * 버퍼별 기억을 지워 다음 draw에서 버퍼 전체를 다시 그리게 함
+ */
+void board_renderer_invalidate(BoardRenderer *r);
+
+/*
+ * 새로 받은 프레임을 셀 전환 상태에 반영
+ */
+void board_renderer_apply(BoardRenderer *r, const BoardFrame *frame);
+
+/*
+ * 전환 상태를 한 프레임 진행시켜 canvas(back 버퍼)에 그림
+ * 반환값: 쓴 픽셀 수. *dirty = 다시 칠한 셀 수, *animating = 아직 전환 중인 셀이 있으면 1
+ */
+int board_renderer_draw(BoardRenderer *r, BoardCanvas *canvas, int *dirty, int *animating);
+
+/*
+ * fp에서 8줄 텍스트 보드 하나를 읽어 frame에 채움 (길이가 8이 아닌 줄을 만나면 처음부터 다시)
+ * hl/flags는 0, input_ns는 호출한 쪽에서 채움
+ * 반환값: 0 = 성공, -1 = EOF
+ */
+int board_read_text_frame(FILE *fp, BoardFrame *frame);
+
+#endif // BOARD_RENDER_H
@@ -0,0 +1,126 @@
+/*
+ * board_shm.h
+ *
+ * client ↔ board 데몬 사이의 바이너리 프레임 프로토콜 (공유 메모리 링 + eventfd).
+ *
+ *   - client가 memfd를 만들어 BoardShm 크기로 mmap 한 뒤, board를 fork+exec 할 때
+ *     memfd와 eventfd 번호를 인자로 넘깁니다.
+ *       board --shm-fd <N> --event-fd <M>
+ *   - client는 프레임을 링 슬롯에 쓰고(board_shm_publish) eventfd에 1을 씁니다.
+ *   - board는 eventfd read()에서 잠들어 있다가 즉시 깨어나 head까지의 프레임을 읽습니다.
+ *
+ * 각 슬롯은 seqlock으로 보호됩니다. 쓰는 중에는 seq = 0, 다 쓰면 seq = frame_seq.
+ * 읽는 쪽은 복사 전후의 seq가 같고 기대한 frame_seq일 때만 프레임을 사용합니다.
+ * (링이 한 바퀴 넘게 밀리면 덮어써진 프레임은 건너뜀)
+ */
+
+#ifndef BOARD_SHM_H
+#define BOARD_SHM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define BOARD_SHM_MAGIC    0x4F435446u   // "OCTF"
+#define BOARD_SHM_VERSION  1
+#define BOARD_SHM_CELLS    64            // 8×8, 행 우선 ('R', 'B', '#', '.')
+#define BOARD_SHM_SLOTS    8             // 링 슬롯 수
+#define BOARD_SHM_MAX_HL   4             // 하이라이트 셀 최대 개수
+
+// 프레임 힌트 플래그
+#define BOARD_FRAME_ANIMATE 0x1u         // 바뀐 셀을 전환 애니메이션으로 표시해도 됨
+
+typedef struct {
+    uint64_t seq;                        // seqlock (0 = 쓰는 중)
+    uint64_t sent_ns;                    // client가 보낸 시각 (CLOCK_MONOTONIC, ns)
+    uint32_t flags;                      // BOARD_FRAME_*
+    uint8_t  hl_count;                   // 하이라이트 셀 개수 (0 ~ BOARD_SHM_MAX_HL)
+    uint8_t  hl_cells[BOARD_SHM_MAX_HL]; // 하이라이트 셀 인덱스 (row * 8 + col)
+    uint8_t  reserved[3];
+    char     cells[BOARD_SHM_CELLS];
+} BoardShmSlot;
+
+typedef struct {
+    uint32_t magic;                      // BOARD_SHM_MAGIC
+    uint16_t version;                    // BOARD_SHM_VERSION
+    uint16_t slot_count;                 // BOARD_SHM_SLOTS
+    uint32_t slot_size;                  // sizeof(BoardShmSlot)
+    uint32_t reserved;
+    uint64_t head;                       // 마지막으로 완성된 frame_seq (0 = 아직 없음)
+    BoardShmSlot slots[BOARD_SHM_SLOTS];
+} BoardShm;
+
+/*
+ * 새로 mmap 한 영역의 헤더 초기화 (client 쪽에서 한 번만 호출)
+ */
+static inline void board_shm_init(BoardShm *shm) {
+    memset(shm, 0, sizeof(*shm));
+    shm->magic = BOARD_SHM_MAGIC;
+    shm->version = BOARD_SHM_VERSION;
+    shm->slot_count = BOARD_SHM_SLOTS;
+    shm->slot_size = (uint32_t)sizeof(BoardShmSlot);
+}
+
+/*
+ * 헤더가 이 빌드의 프로토콜과 맞는지 검사 (board 쪽). 맞으면 1
+ */
+static inline int board_shm_compatible(const BoardShm *shm) {
+    return shm->magic == BOARD_SHM_MAGIC &&
+           shm->version == BOARD_SHM_VERSION &&
+           shm->slot_count == BOARD_SHM_SLOTS &&
+           shm->slot_size == sizeof(BoardShmSlot);
+}
+
+/*
+ * 프레임 하나를 다음 슬롯에 쓰고 head를 올림 (writer는 client 하나뿐)
+ * 반환값: 이번 프레임의 frame_seq
+ */
+static inline uint64_t board_shm_publish(BoardShm *shm, const char cells[BOARD_SHM_CELLS],
+                                         uint32_t flags, const uint8_t *hl_cells,
+                                         int hl_count, uint64_t sent_ns) {
+    uint64_t seq = __atomic_load_n(&shm->head, __ATOMIC_RELAXED) + 1;
+    BoardShmSlot *slot = &shm->slots[seq % BOARD_SHM_SLOTS];
+
+    if (hl_count < 0) hl_count = 0;
+    if (hl_count > BOARD_SHM_MAX_HL) hl_count = BOARD_SHM_MAX_HL;
+
+    // seq = 0 이 데이터보다 먼저 보이도록 release 펜스
+    __atomic_store_n(&slot->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    slot->sent_ns = sent_ns;
+    slot->flags = flags;
+    slot->hl_count = (uint8_t)hl_count;
+    for (int i = 0; i < hl_count; i++) slot->hl_cells[i] = hl_cells[i];
+    memcpy(slot->cells, cells, BOARD_SHM_CELLS);
+
+    __atomic_store_n(&slot->seq, seq, __ATOMIC_RELEASE);
+    __atomic_store_n(&shm->head, seq, __ATOMIC_RELEASE);
+    return seq;
+}
+
+/*
+ * 마지막으로 완성된 frame_seq (board 쪽)
+ */
+static inline uint64_t board_shm_head(const BoardShm *shm) {
+    return __atomic_load_n(&shm->head, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * frame_seq == seq 인 프레임을 out으로 복사. 이미 덮어써졌거나 쓰는 중이면 0
+ */
+static inline int board_shm_read(const BoardShm *shm, uint64_t seq, BoardShmSlot *out) {
+    const BoardShmSlot *slot = &shm->slots[seq % BOARD_SHM_SLOTS];
+
+    uint64_t before = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+    if (before != seq) return 0;
+    memcpy(out, slot, sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t after = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+    if (after != seq) return 0;
+
+    if (out->hl_count > BOARD_SHM_MAX_HL) out->hl_count = BOARD_SHM_MAX_HL;
+    out->seq = seq;
+    return 1;
+}
+
+#endif // BOARD_SHM_H
@@ -7,15 +7,21 @@
  *   3) 서버로 move JSON 전송
  *
  * 내부적으로는 “board”라는 실행 파일을 fork+exec 하여 LED 매트릭스 갱신 데몬을 생성하고,
- * 파이프로 8×8 보드 데이터를 전달합니다.
+ * 공유 메모리 프레임 링 + eventfd로 8×8 보드 데이터를 전달합니다. (board_shm.h 참고)
  *
  * 컴파일 예:
- *   gcc -O2 -o client client.c -lcjson
+ *   gcc -O2 -o client client.c trace.c -lcjson   (board_shm.h가 같은 디렉터리에 있어야 함)
  *
  * 실행 예:
  *   sudo ./client -ip <서버_IP> -port <포트> -username <이름>
+ *
+ * 턴 지연 추적 (trace.h):
+ *   게임이 끝나면 단계별(net.read, json.parse, led.publish, ai.greedy_move, net.write_move, turn)
+ *   p50/p99 요약을 stderr에 출력합니다. 환경 변수 OCTAFLIP_TRACE=<파일>을 주면
+ *   Chrome trace-event JSON을 <파일>에, board 데몬 쪽 span은 <파일>.board.json에 저장합니다.
  */
 
+ #define _GNU_SOURCE   // memfd_create
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
@@ -27,15 +33,21 @@
  #include <sys/types.h>
  #include <sys/wait.h>
  #include <fcntl.h>
+ #include <stdint.h>
+ #include <sys/mman.h>
+ #include <sys/eventfd.h>
+ #include <sys/prctl.h>
  #include "cJSON.h"
+ #include "board_shm.h"
+ #include "trace.h"
  
  #define SIZE 8
- #define PIPE_READ  0
- #define PIPE_WRITE 1
  
- // 전역 변수: LED 데몬(forked process)의 PID 및 파이프 FD
+ // 전역 변수: LED 데몬(forked process)의 PID, 공유 메모리 프레임 링 및 eventfd
  static pid_t board_daemon_pid = -1;
- static int board_pipe_fd[2] = { -1, -1 };
+ static int board_shm_fd = -1;
+ static int board_event_fd = -1;
+ static BoardShm *board_shm = NULL;
  
  // SIGPIPE 무시 (파이프 깨져도 프로세스가 죽지 않도록)
  static void sigpipe_handler(int signum) {
@@ -44,7 +56,9 @@
  
  // 프로토타입 선언 (이 파일 내부의 static 함수와 AI 함수)
  static void init_board_daemon(void);
- static void draw_board_daemon(char board[SIZE][SIZE]);
+ static void draw_board_daemon(char board[SIZE][SIZE], uint32_t flags,
+                               const uint8_t *hl_cells, int hl_count);
+ static void finish_trace(void);
  static void greedy_move_generate(char board[SIZE][SIZE], char my_color,
                                    int *r1, int *c1, int *r2, int *c2);
  
@@ -115,25 +129,35 @@
      init_board_daemon();
  
      // 4) 메인 루프: 서버 메시지 처리
+     trace_set_thread_name("client");
      while (1) {
          // (4-1) recv_json: 한 줄(\n) 단위로 읽어 cJSON 객체로 파싱
+         //       net.read span은 상대 차례를 기다리는 시간을 빼기 위해 첫 바이트 수신부터 잼
          static char buffer[8192];
          int idx = 0;
+         uint64_t t_first_byte = 0;
          while (1) {
              char ch;
              int n = read(sockfd, &ch, 1);
              if (n <= 0) {
                  fprintf(stderr, "서버 연결이 끊어졌습니다.\n");
                  close(sockfd);
+                 finish_trace();
                  return 0;
              }
+             if (t_first_byte == 0) t_first_byte = trace_now_ns();
              if (ch == '\n') {
                  buffer[idx] = '\0';
                  break;
              }
              if (idx < (int)sizeof(buffer)-1) buffer[idx++] = ch;
          }
+         uint64_t t_line = trace_now_ns();
+         trace_span("net.read", t_first_byte, t_line);
+ 
          cJSON *msg = cJSON_Parse(buffer);
+         uint64_t t_parsed = trace_now_ns();
+         trace_span("json.parse", t_line, t_parsed);
          if (!msg) {
              // JSON 파싱 실패
              continue;
@@ -158,14 +182,27 @@
                  }
              }
  
-             // (b) LED 매트릭스 갱신 (board 데몬으로 파이프 전송)
-             draw_board_daemon(board8x8);
+             // (b) LED 매트릭스 갱신 (board 데몬으로 프레임 전송, 상대 수로 뒤집힌 칸은 페이드 전환)
+             uint64_t t0 = trace_now_ns();
+             draw_board_daemon(board8x8, BOARD_FRAME_ANIMATE, NULL, 0);
+             trace_span("led.publish", t0, trace_now_ns());
  
              // (c) AI 로직: Greedy (백혈구는 'W')
              int r1, c1, r2, c2;
+             t0 = trace_now_ns();
              greedy_move_generate(board8x8, 'W', &r1, &c1, &r2, &c2);
+             trace_span("ai.greedy_move", t0, trace_now_ns());
+ 
+             // (c-1) 고른 수의 출발/도착 칸을 하이라이트해서 한 번 더 표시
+             if (r1 >= 0) {
+                 uint8_t hl[2] = { (uint8_t)(r1 * SIZE + c1), (uint8_t)(r2 * SIZE + c2) };
+                 t0 = trace_now_ns();
+                 draw_board_daemon(board8x8, 0, hl, 2);
+                 trace_span("led.publish", t0, trace_now_ns());
+             }
  
              // (d) 서버로 move 전송 (1-based 인덱스)
+             t0 = trace_now_ns();
              cJSON_Delete(msg);
              cJSON *mv = cJSON_CreateObject();
              cJSON_AddStringToObject(mv, "type", "move");
@@ -187,6 +224,11 @@
              write(sockfd, "\n", 1);
              free(mv_str);
              cJSON_Delete(mv);
+             uint64_t t_sent = trace_now_ns();
+             trace_span("net.write_move", t0, t_sent);
+ 
+             // 이번 턴 전체: your_turn 첫 바이트 수신 → move 전송 완료
+             trace_span("turn", t_first_byte, t_sent);
          }
          // (4-3) 기타 메시지 처리 (move_ok, invalid_move, pass, game_over)
          else if (strcmp(type->valuestring, "game_over") == 0) {
@@ -200,13 +242,32 @@
      }
  
      close(sockfd);
+     finish_trace();
      return 0;
  }
  
+ // --------------------------------------------------------------------------------------
+ // finish_trace: 게임 종료 시 턴 단계별 지연 요약 출력 및 (OCTAFLIP_TRACE가 있으면) JSON 덤프
+ // --------------------------------------------------------------------------------------
+ static void finish_trace(void)
+ {
+     trace_print_summary(stderr, "client per-turn stages");
+ 
+     const char *path = getenv("OCTAFLIP_TRACE");
+     if (path && path[0] != '\0') {
+         if (trace_dump_chrome(path) < 0) {
+             perror("finish_trace: trace 저장 실패");
+         } else {
+             fprintf(stderr, "[trace] Chrome trace 저장: %s\n", path);
+         }
+     }
+ }
+ 
  // --------------------------------------------------------------------------------------
  // init_board_daemon: LED 데몬(board)를 fork+exec 하는 함수
  //   - board 데몬은 board.c로 컴파일된 실행 파일 "board"를 의미합니다.
- //   - 파이프(board_pipe_fd)를 통해 부모 → 자식 (board 데몬)으로 8×8 보드 데이터를 보냅니다.
+ //   - memfd로 만든 공유 메모리(BoardShm)와 eventfd를 자식에게 물려주고,
+ //     fd 번호는 "--shm-fd", "--event-fd" 인자로 알려 줍니다.
  // --------------------------------------------------------------------------------------
  static void init_board_daemon(void)
  {
@@ -215,57 +276,97 @@
      // SIGPIPE 무시
      signal(SIGPIPE, sigpipe_handler);
  
-     // 파이프 생성
-     if (pipe(board_pipe_fd) < 0) {
-         perror("init_board_daemon: pipe 생성 실패");
+     // 공유 메모리 프레임 링 생성 (exec 후에도 물려주도록 CLOEXEC 없이 생성)
+     board_shm_fd = memfd_create("octaflip-board", 0);
+     if (board_shm_fd < 0) {
+         perror("init_board_daemon: memfd_create 실패");
          exit(1);
      }
+     if (ftruncate(board_shm_fd, sizeof(BoardShm)) < 0) {
+         perror("init_board_daemon: ftruncate 실패");
+         exit(1);
+     }
+     void *p = mmap(NULL, sizeof(BoardShm), PROT_READ | PROT_WRITE, MAP_SHARED, board_shm_fd, 0);
+     if (p == MAP_FAILED) {
+         perror("init_board_daemon: mmap 실패");
+         exit(1);
+     }
+     board_shm = (BoardShm *)p;
+     board_shm_init(board_shm);
  
+     // 새 프레임 알림용 eventfd
+     board_event_fd = eventfd(0, 0);
+     if (board_event_fd < 0) {
+         perror("init_board_daemon: eventfd 생성 실패");
+         exit(1);
+     }
+ 
+     pid_t parent_pid = getpid();  // 자식에서 PDEATHSIG 설정 전에 부모가 죽었는지 확인용
      pid_t pid = fork();
      if (pid < 0) {
          perror("init_board_daemon: fork 실패");
          exit(1);
      }
      else if (pid == 0) {
-         // 자식 프로세스: board 실행 파일을 stdin으로 pipe_fd[0]을 연결 후 execlp
-         close(board_pipe_fd[1]);  // 쓰기용은 부모만 사용
-         dup2(board_pipe_fd[0], STDIN_FILENO);
-         close(board_pipe_fd[0]);
-         execlp("board", "board", NULL);
+         // 자식 프로세스: client가 죽으면 데몬도 SIGTERM으로 정리되도록 설정
+         // (공유 메모리 모드에서는 파이프 EOF 같은 종료 신호가 없음)
+         prctl(PR_SET_PDEATHSIG, SIGTERM);
+         // fork()와 prctl() 사이에 client가 이미 종료했으면 시그널이 오지 않으므로 바로 종료
+         // (그대로 실행하면 데몬이 eventfd read()에서 영원히 대기)
+         if (getppid() != parent_pid) _exit(0);
+ 
+         // fd 번호를 인자로 넘겨 board 실행 (trace를 켰으면 데몬 쪽 span 저장 경로도 전달)
+         char shm_arg[16], event_arg[16], trace_arg[512];
+         snprintf(shm_arg, sizeof(shm_arg), "%d", board_shm_fd);
+         snprintf(event_arg, sizeof(event_arg), "%d", board_event_fd);
+         const char *trace_path = getenv("OCTAFLIP_TRACE");
+         if (trace_path && trace_path[0] != '\0') {
+             snprintf(trace_arg, sizeof(trace_arg), "%s.board.json", trace_path);
+             execlp("board", "board", "--shm-fd", shm_arg, "--event-fd", event_arg,
+                    "--trace", trace_arg, (char *)NULL);
+         } else {
+             execlp("board", "board", "--shm-fd", shm_arg, "--event-fd", event_arg, (char *)NULL);
+         }
          // 실행 실패 시
          perror("init_board_daemon: execlp 실패 (board 실행)");
          exit(1);
      }
      else {
-         // 부모 프로세스: 자식 PID 저장, 읽기용 FD 닫기
+         // 부모 프로세스: 자식 PID 저장. 매핑은 유지되므로 memfd는 닫아도 됨
          board_daemon_pid = pid;
-         close(board_pipe_fd[0]);
-         // board_pipe_fd[1]는 draw_board_daemon() 호출 시 사용
+         close(board_shm_fd);
+         board_shm_fd = -1;
+         // board_shm, board_event_fd는 draw_board_daemon() 호출 시 사용
      }
  }
  
  // --------------------------------------------------------------------------------------
- // draw_board_daemon: 8×8 보드 데이터를 파이프로 board 데몬에 전달하여 
- //                   LED 매트릭스를 갱신하도록 하는 함수
+ // draw_board_daemon: 8×8 보드를 공유 메모리 링에 프레임으로 쓰고 eventfd로 board 데몬을
+ //                   깨워 LED 매트릭스를 갱신하도록 하는 함수
+ //   - flags: BOARD_FRAME_* 힌트 (BOARD_FRAME_ANIMATE면 바뀐 칸을 페이드로 전환)
+ //   - hl_cells: 하이라이트할 칸 (row * 8 + col), 없으면 NULL / 0
  // --------------------------------------------------------------------------------------
- static void draw_board_daemon(char board[SIZE][SIZE])
+ static void draw_board_daemon(char board[SIZE][SIZE], uint32_t flags,
+                               const uint8_t *hl_cells, int hl_count)
  {
-     if (board_daemon_pid < 0 || board_pipe_fd[1] < 0) {
+     if (board_daemon_pid < 0 || board_shm == NULL) {
          // init_board_daemon이 안 되어 있으면 먼저 초기화
          init_board_daemon();
      }
-     // 부모 프로세스: pipe에 8줄(각각 8문자 + '\n')을 출력
-     FILE *fp = fdopen(board_pipe_fd[1], "w");
-     if (!fp) {
-         perror("draw_board_daemon: fdopen 실패");
-         return;
-     }
+ 
+     char cells[BOARD_SHM_CELLS];
      for (int i = 0; i < SIZE; i++) {
-         fwrite(board[i], 1, SIZE, fp);
-         fputc('\n', fp);
+         memcpy(&cells[i * SIZE], board[i], SIZE);
+     }
+ 
+     // sent_ns는 board 데몬의 입력 → 화면 지연 기준이므로 데몬과 같은 시계(trace_now_ns) 사용
+     board_shm_publish(board_shm, cells, flags, hl_cells, hl_count, trace_now_ns());
+ 
+     // 데몬 깨우기 (데몬이 죽었어도 eventfd write는 실패하지 않음)
+     uint64_t one = 1;
+     if (write(board_event_fd, &one, sizeof(one)) != (ssize_t)sizeof(one)) {
+         perror("draw_board_daemon: eventfd write 실패");
      }
-     fflush(fp);
-     // 파이프를 닫지 않고 재사용 (데몬은 무한 루프 중이므로)
  }
  
  // --------------------------------------------------------------------------------------
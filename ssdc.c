@@ -1,7 +1,46 @@
+/*
+ * ssdc.c
+ *
+ * 페이지 매핑 FTL + greedy GC SSD 시뮬레이터.
+ *
+ * 컴파일 예:
+ *   gcc -O2 -o ssdc ssdc.c
+ *
+ * 실행 예:
+ *   ./ssdc                          (test-fio-small 트레이스 파일 재생, 8GiB마다 통계 출력)
+ *   ./ssdc trace.txt                (다른 트레이스 파일 재생)
+ *   blkparse ... | conv | ./ssdc --stream -               (stdin으로 실시간 트레이스 입력)
+ *   ./ssdc --stream unix:/tmp/ssdc.sock --binary           (UNIX 소켓으로 입력, 연결이 끊기면 다음 연결 대기)
+ *
+ * 스트리밍 옵션:
+ *   --stream <-|unix:PATH>     파일 대신 stdin 또는 UNIX 소켓에서 IORequest를 계속 읽음
+ *   --binary                   텍스트 줄 대신 BinaryIORecord(32바이트, 호스트 바이트 순서) 레코드
+ *   --window <N>               timestamp 재정렬 창 크기 (레코드 수, 기본 1024)
+ *   --report-interval <SEC>    구간 WAF/Utilization/ERASE 출력 주기 (초, 기본 1, 0이면 끄기)
+ *   --idle-flush <SEC>         입력이 이 시간 동안 없으면 재정렬 창에 남은 요청을 모두 처리
+ *                              (초, 기본 1, 0이면 창이 차거나 연결이 끝날 때만 처리)
+ *
+ * 스트리밍 모드는 입력 버퍼(STREAM_BUF_SIZE)와 재정렬 창이 고정 크기라 메모리가 일정하며,
+ * 버퍼를 다 처리한 뒤에만 다시 읽으므로 시뮬레이터가 느리면 파이프/소켓이 차서 생산자가 블록됩니다.
+ * 창보다 더 늦게 도착한 레코드는 버리지 않고 바로 처리하되 late로 집계합니다.
+ * 생산자가 조용해지면 --idle-flush 뒤에 창을 비우므로 구간 통계가 창 크기만큼 뒤처지지 않습니다.
+ * 소켓 연결이 끝날 때와 다음 연결을 기다리는 동안에도 리포트를 출력합니다.
+ * SIGINT/SIGTERM을 받으면 창에 남은 요청을 처리하고 최종 통계를 출력한 뒤 종료합니다.
+ */
+
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #define PageSize 4096  // 페이지 크기 (4KB)
 #define BlockSize (4L * 1024 * 1024)  // 블록 크기 (4MB)
@@ -13,6 +52,10 @@
 #define GCBoundary (8L * 1000 * 1000 * 1000)  // 8GB마다 통계 출력
 #define FreeBlockThreshold 3
 #define LAB_NUM (LogicalSize / PageSize)  // LBA 수
+#define STREAM_BUF_SIZE (64 * 1024)  // 스트리밍 입력 버퍼 크기
+#define DEFAULT_REORDER_WINDOW 1024  // 기본 재정렬 창 크기 (레코드 수)
+#define DEFAULT_IDLE_FLUSH 1.0  // 입력이 없을 때 재정렬 창을 비우기까지 대기 (초)
+#define MAX_LINE_LEN 256  // 텍스트 레코드 한 줄 최대 길이
 
 typedef struct {
     bool valid;  // 페이지 유효성
@@ -39,6 +82,40 @@ typedef struct {
     unsigned int stream_number;
 } IORequest;
 
+// --binary 스트림 레코드 (호스트 바이트 순서, 패딩 없이 32바이트)
+typedef struct {
+    double timestamp;
+    uint32_t io_type;
+    uint32_t size;
+    uint64_t lba;
+    uint32_t stream_number;
+    uint32_t reserved;
+} BinaryIORecord;
+
+// 재정렬 창 (timestamp 최소 힙). 같은 timestamp는 도착 순서(seq) 유지
+typedef struct {
+    IORequest request;
+    unsigned long seq;
+} PendingRequest;
+
+typedef struct {
+    PendingRequest *items;  // capacity개를 시작할 때 한 번만 할당
+    int count;
+    int capacity;
+    unsigned long next_seq;
+    double watermark;  // 마지막으로 처리한 timestamp
+    bool started;
+} ReorderWindow;
+
+// 스트리밍 입력 (고정 크기 버퍼)
+typedef struct {
+    int fd;
+    bool binary;
+    bool discarding;  // 너무 긴 줄의 나머지를 버리는 중
+    size_t start, end;  // buf[start, end)가 아직 처리하지 않은 데이터
+    char buf[STREAM_BUF_SIZE];
+} StreamInput;
+
 // 글로벌 변수들
 Block *blocks;
 SSD ssd;
@@ -52,6 +129,7 @@ unsigned int progress_boundary = 8;
 int remainFreeBlocks = 0;
 unsigned long utl = 0;  // Utilization을 위한 페이지 수
 unsigned long erase_count = 0; // ERASE 횟수 추적
+unsigned long out_of_range_pages = 0;  // LAB_NUM을 넘는 LBA라 무시한 페이지 수
 
 // 누적 데이터 추적 변수
 unsigned long cumulative_written_data = 0;
@@ -255,6 +333,29 @@ void Statistics() {
     
 }
 
+// 요청 하나 처리 (파일/스트리밍 공용). 반환값: 사용자 쓰기 바이트 수
+unsigned long handleRequest(const IORequest *request) {
+    unsigned long written = 0;
+    if (request->io_type == 1) {  // 실제 사용자 데이터 쓰기
+        unsigned int num_pages = (request->size + PageSize - 1) / PageSize; // 페이지 수 계산
+        for (unsigned int i = 0; i < num_pages; i++) {
+            unsigned long lba = request->lba + i;
+            if (lba >= LAB_NUM) {  // 논리 크기를 넘는 LBA는 매핑 테이블 밖이므로 무시
+                out_of_range_pages++;
+                continue;
+            }
+            writePage(lba, 0);
+            written += PageSize;
+        }
+    }
+    if (remainFreeBlocks < FreeBlockThreshold) {
+        while (remainFreeBlocks < FreeBlockThreshold) {
+            GC();
+        }
+    }
+    return written;
+}
+
 void processRequests(const char *filename) {
     FILE *file = fopen(filename, "r");
     if (!file) {
@@ -263,19 +364,8 @@ void processRequests(const char *filename) {
     }
     IORequest request;
     unsigned long processed_data = 0;
-    while (fscanf(file, "%lf %d %lu %u %u", &request.timestamp, &request.io_type, &request.lba, &request.size, &request.stream_number) != EOF) {
-        if (request.io_type == 1) {  // 실제 사용자 데이터 쓰기
-            unsigned int num_pages = (request.size + PageSize - 1) / PageSize; // 페이지 수 계산
-            for (unsigned int i = 0; i < num_pages; i++) {
-                writePage(request.lba + i, 0);
-                processed_data += PageSize;
-            }
-        }
-        if (remainFreeBlocks < FreeBlockThreshold) {
-            while (remainFreeBlocks < FreeBlockThreshold) {
-                GC();
-            }
-        }
+    while (fscanf(file, "%lf %d %lu %u %u", &request.timestamp, &request.io_type, &request.lba, &request.size, &request.stream_number) == 5) {
+        processed_data += handleRequest(&request);
         if (processed_data >= GCBoundary) {
             Statistics();
             progress_boundary += 8;
@@ -285,11 +375,407 @@ void processRequests(const char *filename) {
     fclose(file);
 }
 
-int main() {
+// ---------------------------------------------------------------------------
+// 스트리밍 모드
+// ---------------------------------------------------------------------------
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void requestStop(int signum) {
+    (void)signum;
+    stop_requested = 1;
+}
+
+static double monotonicSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 구간 통계 (직전 리포트 이후 변화량 계산용)
+typedef struct {
+    double start_time;
+    double last_time;
+    unsigned long requests;
+    unsigned long late;
+    unsigned long malformed;
+    unsigned long last_requests;
+    unsigned long last_user;
+    unsigned long last_gc;
+    unsigned long last_erase;
+} StreamStats;
+
+static bool pendingLess(const PendingRequest *a, const PendingRequest *b) {
+    if (a->request.timestamp != b->request.timestamp) {
+        return a->request.timestamp < b->request.timestamp;
+    }
+    return a->seq < b->seq;
+}
+
+// 최소 힙에서 가장 이른 요청을 꺼냄 (count > 0일 때만 호출)
+static IORequest windowPop(ReorderWindow *w) {
+    IORequest top = w->items[0].request;
+    w->items[0] = w->items[--w->count];
+    int i = 0;
+    while (1) {
+        int l = 2 * i + 1, r = l + 1, m = i;
+        if (l < w->count && pendingLess(&w->items[l], &w->items[m])) m = l;
+        if (r < w->count && pendingLess(&w->items[r], &w->items[m])) m = r;
+        if (m == i) break;
+        PendingRequest tmp = w->items[i];
+        w->items[i] = w->items[m];
+        w->items[m] = tmp;
+        i = m;
+    }
+    return top;
+}
+
+static void windowRelease(ReorderWindow *w, const IORequest *request) {
+    w->watermark = request->timestamp;
+    w->started = true;
+    handleRequest(request);
+}
+
+// 요청을 창에 넣고, 창이 가득 차면 가장 이른 요청부터 처리
+static void windowPush(ReorderWindow *w, StreamStats *st, const IORequest *request) {
+    st->requests++;
+    // 이미 처리한 시각보다 이른 요청은 창으로 되돌릴 수 없으므로 바로 처리
+    if (w->started && request->timestamp < w->watermark) {
+        st->late++;
+        handleRequest(request);
+        return;
+    }
+    if (w->count == w->capacity) {
+        IORequest earliest = windowPop(w);
+        windowRelease(w, &earliest);
+        // 방금 내보낸 요청보다 이르면 그대로 늦은 요청
+        if (request->timestamp < w->watermark) {
+            st->late++;
+            handleRequest(request);
+            return;
+        }
+    }
+    int i = w->count++;
+    w->items[i].request = *request;
+    w->items[i].seq = w->next_seq++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!pendingLess(&w->items[i], &w->items[parent])) break;
+        PendingRequest tmp = w->items[i];
+        w->items[i] = w->items[parent];
+        w->items[parent] = tmp;
+        i = parent;
+    }
+}
+
+static void windowDrain(ReorderWindow *w) {
+    while (w->count > 0) {
+        IORequest earliest = windowPop(w);
+        windowRelease(w, &earliest);
+    }
+}
+
+// 버퍼에서 레코드 하나를 꺼냄. 1: 성공, 0: 데이터가 더 필요함. 잘못된 텍스트 줄은 건너뜀
+static int nextRecord(StreamInput *in, StreamStats *st, IORequest *request) {
+    if (in->binary) {
+        if (in->end - in->start < sizeof(BinaryIORecord)) return 0;
+        BinaryIORecord rec;
+        memcpy(&rec, in->buf + in->start, sizeof(rec));
+        in->start += sizeof(rec);
+        request->timestamp = rec.timestamp;
+        request->io_type = (int)rec.io_type;
+        request->lba = (unsigned long)rec.lba;
+        request->size = rec.size;
+        request->stream_number = rec.stream_number;
+        return 1;
+    }
+
+    while (in->start < in->end) {
+        char *line = in->buf + in->start;
+        char *nl = (char *)memchr(line, '\n', in->end - in->start);
+        if (!nl) {
+            // 한 줄이 너무 길면 줄 끝까지 버림 (버퍼가 줄 하나에 묶이지 않도록)
+            if (in->end - in->start >= MAX_LINE_LEN) {
+                in->start = in->end;
+                if (!in->discarding) st->malformed++;
+                in->discarding = true;
+            }
+            return 0;
+        }
+        *nl = '\0';
+        in->start = (size_t)(nl - in->buf) + 1;
+        if (in->discarding) {
+            in->discarding = false;
+            continue;
+        }
+        if (line[strspn(line, " \t\r")] == '\0') continue;  // 빈 줄
+        if (sscanf(line, "%lf %d %lu %u %u", &request->timestamp, &request->io_type,
+                   &request->lba, &request->size, &request->stream_number) == 5) {
+            return 1;
+        }
+        st->malformed++;
+    }
+    return 0;
+}
+
+// 남은 데이터를 앞으로 당기고 한 번 읽음. 반환값: 읽은 바이트 수, 0: EOF, -1: 오류/인터럽트
+static ssize_t fillInput(StreamInput *in) {
+    if (in->start > 0) {
+        memmove(in->buf, in->buf + in->start, in->end - in->start);
+        in->end -= in->start;
+        in->start = 0;
+    }
+    ssize_t n = read(in->fd, in->buf + in->end, sizeof(in->buf) - in->end);
+    if (n > 0) in->end += (size_t)n;
+    return n;
+}
+
+// WAF = (사용자 + GC 쓰기) / 사용자 쓰기. 사용자 쓰기가 없으면 정의되지 않으므로 "n/a"
+static const char *formatWAF(char *buf, size_t len, unsigned long user, unsigned long gc) {
+    if (user == 0) return "n/a";
+    snprintf(buf, len, "%.3f", (double)(user + gc) / (double)user);
+    return buf;
+}
+
+static void streamReport(StreamStats *st, const ReorderWindow *w) {
+    double now = monotonicSeconds();
+    unsigned long du = user_written_data - st->last_user;
+    unsigned long dg = gc_written_data - st->last_gc;
+    char waf[16], window_waf[16];
+    double utilization = (double)(utl) / (double)(LAB_NUM);
+    double elapsed = now - st->last_time;
+
+    printf("[Stream %.1fs] REQ: %lu (%.0f/s), USER: %.3f GiB (+%.3f), WAF: %s, WINDOW_WAF: %s, "
+           "Utilization: %.3f, ERASE: %lu (+%lu), FREE: %d, PENDING: %d, LATE: %lu, BAD: %lu\n",
+           now - st->start_time, st->requests,
+           elapsed > 0 ? (st->requests - st->last_requests) / elapsed : 0.0,
+           user_written_data * (double)PageSize / (1024.0 * 1024 * 1024),
+           du * (double)PageSize / (1024.0 * 1024 * 1024),
+           formatWAF(waf, sizeof(waf), user_written_data, gc_written_data),
+           formatWAF(window_waf, sizeof(window_waf), du, dg), utilization,
+           erase_count, erase_count - st->last_erase,
+           remainFreeBlocks, w->count, st->late, st->malformed);
+    fflush(stdout);
+
+    st->last_time = now;
+    st->last_requests = st->requests;
+    st->last_user = user_written_data;
+    st->last_gc = gc_written_data;
+    st->last_erase = erase_count;
+}
+
+// 리포트 주기가 되었으면 출력. 반환값: 다음 리포트까지 poll 대기 시간 (ms, 리포트를 끄면 -1)
+static int reportIfDue(StreamStats *st, const ReorderWindow *w, double report_interval) {
+    if (report_interval <= 0) return -1;
+    double due = st->last_time + report_interval - monotonicSeconds();
+    if (due <= 0) {
+        streamReport(st, w);
+        due = report_interval;
+    }
+    return (int)(due * 1000) + 1;
+}
+
+// 연결(또는 stdin) 하나를 EOF까지 처리. 중단 요청이면 false
+static bool streamSession(StreamInput *in, ReorderWindow *w, StreamStats *st,
+                          double report_interval, double idle_flush) {
+    in->start = in->end = 0;
+    in->discarding = false;
+    double last_input = monotonicSeconds();
+
+    while (!stop_requested) {
+        IORequest request;
+        while (nextRecord(in, st, &request)) {
+            windowPush(w, st, &request);
+        }
+
+        // 입력이 한동안 없으면 창에 남은 요청 처리 (생산자가 조용할 때 통계가 창만큼 밀리지 않도록)
+        int flush_timeout = -1;
+        if (idle_flush > 0 && w->count > 0) {
+            double idle_left = last_input + idle_flush - monotonicSeconds();
+            if (idle_left <= 0) {
+                windowDrain(w);
+            } else {
+                flush_timeout = (int)(idle_left * 1000) + 1;
+            }
+        }
+
+        // 입력이 없어도 리포트 주기와 idle flush는 지키도록 그중 이른 시각까지만 대기
+        int timeout = reportIfDue(st, w, report_interval);
+        if (flush_timeout >= 0 && (timeout < 0 || flush_timeout < timeout)) timeout = flush_timeout;
+        struct pollfd pfd = { in->fd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            perror("poll");
+            return false;
+        }
+        if (ready == 0) continue;
+
+        ssize_t n = fillInput(in);
+        if (n > 0) last_input = monotonicSeconds();
+        if (n == 0) {
+            // 개행 없이 끝난 마지막 텍스트 줄은 처리 (fillInput이 앞으로 당겨 두었으므로 자리가 있음)
+            if (!in->binary && !in->discarding && in->end > in->start) {
+                in->buf[in->end++] = '\n';
+                while (nextRecord(in, st, &request)) {
+                    windowPush(w, st, &request);
+                }
+            }
+            if (in->end > in->start) st->malformed++;  // 끝에 잘린 레코드
+            return true;
+        }
+        if (n < 0 && errno != EINTR) {
+            perror("read");
+            return true;
+        }
+    }
+    return false;
+}
+
+static int openUnixListener(const char *path) {
+    struct sockaddr_un addr;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path);  // 이전 실행이 남긴 소켓 파일
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1) < 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// source: "-" (stdin) 또는 "unix:PATH". 중단 요청이나 stdin EOF까지 실행
+int streamRequests(const char *source, bool binary, int window_size,
+                   double report_interval, double idle_flush) {
+    static StreamInput in;
+    ReorderWindow w;
+    memset(&w, 0, sizeof(w));
+    w.capacity = window_size;
+    w.items = (PendingRequest *)malloc(sizeof(PendingRequest) * window_size);
+    if (!w.items) {
+        perror("malloc");
+        return -1;
+    }
+    in.binary = binary;
+
+    StreamStats st;
+    memset(&st, 0, sizeof(st));
+    st.start_time = st.last_time = monotonicSeconds();
+
+    // SA_RESTART 없이 등록해서 블록된 poll/accept가 EINTR로 깨어나게 함
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = requestStop;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    int ret = 0;
+    if (strcmp(source, "-") == 0) {
+        in.fd = STDIN_FILENO;
+        streamSession(&in, &w, &st, report_interval, idle_flush);
+    } else if (strncmp(source, "unix:", 5) == 0) {
+        const char *path = source + 5;
+        int listen_fd = openUnixListener(path);
+        if (listen_fd < 0) {
+            ret = -1;
+        } else {
+            fprintf(stderr, "Listening on %s\n", path);
+            while (!stop_requested) {
+                // 다음 연결을 기다리는 동안에도 리포트 주기 유지
+                struct pollfd pfd = { listen_fd, POLLIN, 0 };
+                int ready = poll(&pfd, 1, reportIfDue(&st, &w, report_interval));
+                if (ready < 0 && errno != EINTR) {
+                    perror("poll");
+                    ret = -1;
+                    break;
+                }
+                if (ready <= 0) continue;
+
+                in.fd = accept(listen_fd, NULL, NULL);
+                if (in.fd < 0) {
+                    if (errno == EINTR) continue;
+                    perror("accept");
+                    ret = -1;
+                    break;
+                }
+                bool more = streamSession(&in, &w, &st, report_interval, idle_flush);
+                close(in.fd);
+                if (!more) break;
+                windowDrain(&w);  // 연결이 끝나면 창에 남은 요청 처리 후 다음 연결 대기
+                streamReport(&st, &w);
+            }
+            close(listen_fd);
+            unlink(path);
+        }
+    } else {
+        fprintf(stderr, "Unknown stream source: %s (use - or unix:PATH)\n", source);
+        ret = -1;
+    }
+
+    windowDrain(&w);
+    // 최종 Statistics()의 Progress 표시를 파일 모드와 같은 기준(8GB 단위)으로 맞춤
+    progress_boundary = 8 + (unsigned int)(user_written_data * PageSize / GCBoundary) * 8;
+    if (st.requests > 0) streamReport(&st, &w);  // 마지막 구간 (주기 리포트를 껐어도 출력)
+    free(w.items);
+    return ret;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [TRACE_FILE]\n"
+                    "       %s --stream <-|unix:PATH> [--binary] [--window <N>] [--report-interval <SEC>]\n"
+                    "                [--idle-flush <SEC>]\n",
+            prog, prog);
+}
+
+int main(int argc, char *argv[]) {
+    const char *trace_file = "test-fio-small";
+    const char *stream_source = NULL;
+    bool binary = false;
+    int window_size = DEFAULT_REORDER_WINDOW;
+    double report_interval = 1.0;
+    double idle_flush = DEFAULT_IDLE_FLUSH;
+
+    for (int i = 1; i < argc; i++) {
+        if      (strcmp(argv[i], "--stream") == 0 && i + 1 < argc)          stream_source = argv[++i];
+        else if (strcmp(argv[i], "--binary") == 0)                          binary = true;
+        else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc)          window_size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--report-interval") == 0 && i + 1 < argc) report_interval = atof(argv[++i]);
+        else if (strcmp(argv[i], "--idle-flush") == 0 && i + 1 < argc)      idle_flush = atof(argv[++i]);
+        else if (argv[i][0] != '-')                                         trace_file = argv[i];
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (window_size <= 0 || report_interval < 0 || idle_flush < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
     initial();
-    processRequests("test-fio-small");
+    int ret = 0;
+    if (stream_source) {
+        ret = streamRequests(stream_source, binary, window_size, report_interval, idle_flush) < 0 ? 1 : 0;
+    } else {
+        processRequests(trace_file);
+    }
 
     Statistics();
+    if (out_of_range_pages > 0) {  // 파일/스트리밍 공통: handleRequest가 버린 쓰기
+        fprintf(stderr, "Ignored %lu pages beyond logical size\n", out_of_range_pages);
+    }
 
     // 메모리 해제
     for (int i = 0; i < TotalBlocks; i++) {
@@ -300,5 +786,5 @@ int main() {
     free(OoBa);
     free(ssd.free_block_queue);
 
-    return 0;
+    return ret;
 }
@@ -0,0 +1,46 @@
+#!/bin/sh
+#
+# check_board_golden.sh
+#
+# LED 하드웨어 없이 (Linux CI 등) board 렌더링 경로를 골든 PPM과 픽셀 단위로 비교합니다.
+#   1) board_bench와 매트릭스 없는 board 데몬(-DBOARD_NO_MATRIX)을 빌드
+#   2) testdata/board_seq.txt (board --record로 기록한 한 게임)를
+#      증분 렌더링 / 페이드 애니메이션 각각으로 재생해 testdata/golden/ 과 비교
+#   3) 같은 시퀀스를 데몬 표준입력으로 보내 마지막으로 표시된 프레임이 마지막 골든과 같은지 확인
+#
+# 실행 예 (저장소 최상위에서):
+#   sh testdata/check_board_golden.sh
+#
+# 골든 다시 만들기 (렌더링을 의도적으로 바꾼 경우만, 전체 다시 그리기 결과를 기준으로 삼음):
+#   build/board_bench testdata/board_seq.txt --iterations 1 --full --golden testdata/golden --update-golden
+#
+# 종료 코드: 0 = 모두 일치, 그 외 = 빌드 실패 또는 불일치
+
+set -e
+cd "$(dirname "$0")/.."
+
+CC=${CC:-gcc}
+CXX=${CXX:-g++}
+BUILD=${BUILD:-build}
+SEQ=testdata/board_seq.txt
+GOLDEN=testdata/golden
+
+mkdir -p "$BUILD"
+$CC -O2 -Wall -o "$BUILD/board_bench" board_bench.c board_render.c board_fb.c
+$CXX -O2 -Wall -DBOARD_NO_MATRIX -o "$BUILD/board" board.c board_render.c board_fb.c trace.c -lpthread
+
+# 증분 렌더링 / 애니메이션 경로가 전체 다시 그리기로 만든 골든과 같은지
+"$BUILD/board_bench" "$SEQ" --iterations 20 --golden "$GOLDEN"
+"$BUILD/board_bench" "$SEQ" --iterations 20 --animate --golden "$GOLDEN"
+
+# 데몬 end-to-end: 마지막 swap 덤프 == 마지막 보드의 골든
+DUMP=$(mktemp -d)
+trap 'rm -rf "$DUMP"' EXIT
+"$BUILD/board" --dump-dir "$DUMP" < "$SEQ" 2> "$DUMP/board.log"
+LAST_DUMP=$(ls "$DUMP"/frame_*.ppm | tail -n 1)
+LAST_GOLDEN=$(ls "$GOLDEN"/board_*.ppm | tail -n 1)
+if ! cmp -s "$LAST_DUMP" "$LAST_GOLDEN"; then
+    echo "board: 마지막 표시 프레임 $LAST_DUMP 이(가) $LAST_GOLDEN 과 다름" >&2
+    exit 1
+fi
+echo "board: daemon final frame matches $LAST_GOLDEN"
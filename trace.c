@@ -0,0 +1,184 @@
+/*
+ * trace.c
+ *
+ * 경량 trace span 기록기 구현 (trace.h 참고).
+ *
+ * 스레드별 링은 처음 기록할 때 할당되어 전역 목록에 CAS로 추가되고, 해제하지 않습니다.
+ * 쓰는 스레드는 span을 채운 뒤 head를 release로 올리기만 하므로 락이 없습니다.
+ * 덤프/요약은 보통 게임이 끝난 뒤 호출하며, 그때 아직 기록 중인 스레드가 있으면
+ * 링이 한 바퀴 도는 경계의 span 몇 개가 섞일 수 있습니다 (진단용이므로 허용).
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+typedef struct {
+    const char *name;
+    uint64_t start_ns;
+    uint64_t end_ns;
+} TraceSpan;
+
+typedef struct TraceRing {
+    struct TraceRing *next;      // 전역 목록 연결
+    int tid;                     // 이 프로세스 안에서의 스레드 번호 (1부터)
+    const char *thread_name;
+    uint64_t head;               // 지금까지 기록한 span 수 (소유 스레드만 증가)
+    TraceSpan spans[TRACE_RING_SIZE];
+} TraceRing;
+
+static TraceRing *rings = NULL;
+static int next_tid = 0;
+static __thread TraceRing *my_ring = NULL;
+
+/*
+ * 현재 스레드의 링 (없으면 할당해서 전역 목록에 등록). 할당 실패 시 NULL
+ */
+static TraceRing *ring_for_thread(void) {
+    if (my_ring) return my_ring;
+
+    TraceRing *r = (TraceRing *)calloc(1, sizeof(TraceRing));
+    if (!r) return NULL;
+    r->tid = __atomic_add_fetch(&next_tid, 1, __ATOMIC_RELAXED);
+    r->next = __atomic_load_n(&rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&rings, &r->next, r, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    my_ring = r;
+    return r;
+}
+
+uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void trace_span(const char *name, uint64_t start_ns, uint64_t end_ns) {
+    TraceRing *r = ring_for_thread();
+    if (!r) return;
+
+    uint64_t h = r->head;
+    TraceSpan *s = &r->spans[h % TRACE_RING_SIZE];
+    s->name = name;
+    s->start_ns = start_ns;
+    s->end_ns = end_ns;
+    __atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+}
+
+void trace_set_thread_name(const char *name) {
+    TraceRing *r = ring_for_thread();
+    if (r) r->thread_name = name;
+}
+
+/*
+ * 링에 남아 있는 span 범위 [*first, head)
+ */
+static uint64_t ring_range(const TraceRing *r, uint64_t *first) {
+    uint64_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    *first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    return head;
+}
+
+/*
+ * JSON 문자열로 안전하게 출력 (span 이름은 보통 리터럴이지만 따옴표/역슬래시는 이스케이프)
+ */
+static void write_json_string(FILE *fp, const char *s) {
+    fputc('"', fp);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', fp);
+        if ((unsigned char)*s < 0x20) continue;
+        fputc(*s, fp);
+    }
+    fputc('"', fp);
+}
+
+int trace_dump_chrome(const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) return -1;
+
+    int pid = (int)getpid();
+    int first_event = 1;
+    fprintf(fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for (TraceRing *r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r; r = r->next) {
+        if (r->thread_name) {
+            fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                        "\"args\":{\"name\":", first_event ? "" : ",\n", pid, r->tid);
+            write_json_string(fp, r->thread_name);
+            fprintf(fp, "}}");
+            first_event = 0;
+        }
+
+        uint64_t first, head = ring_range(r, &first);
+        for (uint64_t i = first; i < head; i++) {
+            const TraceSpan *s = &r->spans[i % TRACE_RING_SIZE];
+            uint64_t dur = s->end_ns > s->start_ns ? s->end_ns - s->start_ns : 0;
+            // ts/dur 단위는 µs (소수점 3자리까지 = ns 정밀도)
+            fprintf(fp, "%s{\"name\":", first_event ? "" : ",\n");
+            write_json_string(fp, s->name);
+            fprintf(fp, ",\"cat\":\"octaflip\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                        "\"pid\":%d,\"tid\":%d}",
+                    s->start_ns / 1e3, dur / 1e3, pid, r->tid);
+            first_event = 0;
+        }
+    }
+
+    fprintf(fp, "\n]}\n");
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+void trace_print_summary(FILE *fp, const char *title) {
+    // span 이름별 소요 시간 모으기 (처음 나온 순서대로)
+    const char *names[TRACE_MAX_STAGES];
+    uint64_t *durs[TRACE_MAX_STAGES];
+    size_t counts[TRACE_MAX_STAGES], caps[TRACE_MAX_STAGES];
+    int n_stages = 0;
+
+    for (TraceRing *r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r; r = r->next) {
+        uint64_t first, head = ring_range(r, &first);
+        for (uint64_t i = first; i < head; i++) {
+            const TraceSpan *s = &r->spans[i % TRACE_RING_SIZE];
+            int k = 0;
+            while (k < n_stages && strcmp(names[k], s->name) != 0) k++;
+            if (k == n_stages) {
+                if (n_stages == TRACE_MAX_STAGES) continue;  // 이름이 너무 많으면 나머지는 무시
+                names[k] = s->name;
+                counts[k] = 0;
+                caps[k] = 64;
+                durs[k] = (uint64_t *)malloc(sizeof(uint64_t) * caps[k]);
+                n_stages++;
+            }
+            if (counts[k] == caps[k]) {
+                caps[k] *= 2;
+                durs[k] = (uint64_t *)realloc(durs[k], sizeof(uint64_t) * caps[k]);
+            }
+            durs[k][counts[k]++] = s->end_ns > s->start_ns ? s->end_ns - s->start_ns : 0;
+        }
+    }
+
+    fprintf(fp, "[trace] %s\n", title);
+    fprintf(fp, "[trace] %-24s %7s %10s %10s %10s %12s\n",
+            "stage", "count", "p50(ms)", "p99(ms)", "max(ms)", "total(ms)");
+    for (int k = 0; k < n_stages; k++) {
+        size_t n = counts[k];
+        uint64_t total = 0;
+        qsort(durs[k], n, sizeof(uint64_t), cmp_u64);
+        for (size_t i = 0; i < n; i++) total += durs[k][i];
+        fprintf(fp, "[trace] %-24s %7zu %10.3f %10.3f %10.3f %12.3f\n",
+                names[k], n,
+                durs[k][(n - 1) / 2] / 1e6,
+                durs[k][(size_t)((n - 1) * 0.99)] / 1e6,
+                durs[k][n - 1] / 1e6,
+                total / 1e6);
+        free(durs[k]);
+    }
+}
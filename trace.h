@@ -0,0 +1,54 @@
+/*
+ * trace.h
+ *
+ * 턴 단위 지연 추적용 경량 trace span 기록기 (client, AI, board 데몬 공용).
+ *
+ *   - 시각은 CLOCK_MONOTONIC (ns). 프로세스가 달라도 같은 시계이므로 타임라인을 합칠 수 있음
+ *   - 스레드마다 고정 크기 링(TRACE_RING_SIZE)에 기록. 쓰는 쪽은 락 없이 자기 링에만 씀
+ *     (링이 차면 가장 오래된 span부터 덮어씀)
+ *   - 끝날 때 Chrome trace-event JSON(chrome://tracing, Perfetto)으로 덤프하고
+ *     단계(span 이름)별 count / p50 / p99 / max 요약을 출력
+ *
+ * 사용 예:
+ *   uint64_t t0 = trace_now_ns();
+ *   cJSON *msg = cJSON_Parse(buffer);
+ *   trace_span("json.parse", t0, trace_now_ns());
+ *
+ * span 이름은 문자열 리터럴처럼 프로그램이 끝날 때까지 유효한 포인터여야 합니다.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define TRACE_RING_SIZE 4096     // 스레드당 보관할 span 수
+#define TRACE_MAX_STAGES 32      // 요약에서 구분할 span 이름 수
+
+/*
+ * CLOCK_MONOTONIC 현재 시각 (ns)
+ */
+uint64_t trace_now_ns(void);
+
+/*
+ * 현재 스레드의 링에 [start_ns, end_ns] span 하나를 기록
+ */
+void trace_span(const char *name, uint64_t start_ns, uint64_t end_ns);
+
+/*
+ * 현재 스레드 이름 (Chrome trace의 thread_name 메타데이터). 리터럴 포인터를 그대로 보관
+ */
+void trace_set_thread_name(const char *name);
+
+/*
+ * 모든 스레드의 span을 Chrome trace-event JSON으로 저장. 성공하면 0, 실패하면 -1
+ */
+int trace_dump_chrome(const char *path);
+
+/*
+ * 단계별 count / p50 / p99 / max / total 요약 출력
+ */
+void trace_print_summary(FILE *fp, const char *title);
+
+#endif // TRACE_H